@@ -1,10 +1,12 @@
 // Oliver.cpp : This file contains the 'main' function. Program execution begins and ends there.
 //
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 
 #include "Oliver.h"
-#include ".\parser\parser.h"
+#include ".\parser\module_cache.h"
 
 int main(Olly::int_type argc, char** argv) {
 
@@ -18,8 +20,8 @@ int main(Olly::int_type argc, char** argv) {
 			Olly::let code_exp = Olly::expression();
 
 			{
-				Olly::parser lex(argv[1]);
-				code_exp = lex.parse();
+				Olly::module_cache cache;
+				code_exp = cache.load(argv[1]);
 			}
 
 			Olly::print("input code = " + repr(code_exp));
@@ -31,10 +33,53 @@ int main(Olly::int_type argc, char** argv) {
 
 			// Olly::print("result code = " + repr(code_exp));
 		}
+
+		if (argc == 3) {
+			/*
+				Benchmark the evaluator by running the code the requested
+				number of times and reporting the cost of each dispatch step.
+			*/
+
+			Olly::let code_exp = Olly::expression();
+
+			{
+				Olly::module_cache cache;
+				code_exp = cache.load(argv[1]);
+			}
+
+			Olly::int_type   runs  = Olly::to<Olly::int_type>(argv[2]);
+			Olly::size_type  steps = 0;
+			Olly::size_type  allocs = 0;
+			Olly::size_type  peak  = 0;
+
+			auto start = std::chrono::steady_clock::now();
+
+			for (Olly::int_type i = 0; i < runs; i += 1) {
+
+				Olly::evaluator olly;
+				olly.eval(code_exp);
+
+				steps  += olly.steps();
+				allocs += olly.allocations().allocations;
+				peak    = std::max(peak, olly.allocations().peak_bytes);
+			}
+
+			auto stop = std::chrono::steady_clock::now();
+
+			double nano_sec = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+
+			std::cout << "runs = " << runs << ", steps = " << steps;
+
+			if (steps) {
+				std::cout << ", ns/step = " << nano_sec / steps;
+			}
+
+			std::cout << ", allocations = " << allocs << ", peak bytes = " << peak << std::endl;
+		}
 	}
 	catch (std::exception& e) {
 		std::cerr << "Error during runtime: " << e.what() << std::endl;
 	}
 
 	return 0;
-}
\ No newline at end of file
+}
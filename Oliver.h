@@ -21,7 +21,11 @@
 //			
 /********************************************************************************************/
 
+#include <unordered_map>
+
 #include ".\eval\types_header.h"
+#include ".\eval\arena.h"
+#include ".\eval\bytecode.h"
 
 namespace Olly {
 
@@ -54,22 +58,30 @@ namespace Olly {
 
 	class evaluator {
 
-		typedef     std::map<str_type, let>  map_type;
 		typedef     std::vector<let>	     stack_type;
-		typedef     std::vector<map_type>	 closure_type;
+		typedef     std::vector<scope>	     closure_type;
+		typedef     std::unordered_map<const void*, code_block>  block_type;
 
 		closure_type                _variables;
 		stack_type                      _stack;
 		stack_type                       _code;
+		block_type                     _blocks;
+		stack_type                      _slots;
 		size_type              _max_stack_size;
+		size_type                       _steps;
+		arena*                          _arena;    // The allocator of the values of the evaluator, if any.
 
 	public:
 		static const size_type DEFAULT_STACK_LIMIT;
 
-		evaluator();
+		evaluator(bool_type use_arena = true);
 		evaluator(evaluator& env) = delete;
+		virtual ~evaluator();
+
+		let eval(let exp);                                                     // The result is taken from the pool, so may be shared between threads.
 
-		let eval(let exp);
+		size_type                   steps()  const;    // The number of dispatch steps taken by the evaluator.
+		allocation_stats      allocations()  const;    // The use made of the arena, else of the pool.
 
 	private:
 
@@ -78,9 +90,17 @@ namespace Olly {
 		inline void eval();
 
 		inline let get_result_stack() const;
+		inline let copy_from_arena(const let& value) const;
 
 		inline void prep_code_to_execute(let& exp) const;
 
+		inline const void* block_address(const let& exp) const;
+		inline void            compile_blocks(const let& exp);
+		inline bool_type            run_block(const let& exp);
+
+		inline bool_type     find_symbol(size_type id, scope_address& addr) const;
+		inline const scope& scope_at(const scope_address& addr) const;
+
 		inline let  get_symbol(let& var) const;
 		inline void set_symbol(let& var, let& val);
 
@@ -89,8 +109,8 @@ namespace Olly {
 		inline void define_enclosure();
 		inline void delete_enclosure();
 
-		inline void  set_expression_on_code(let exp);
-		inline void set_expression_on_stack(let exp);
+		inline void  set_expression_on_code(const let& exp);
+		inline void set_expression_on_stack(let exp);                          // Taken by value, so a temporary is moved onto the stack.
 
 		inline let get_expression_from_stack();
 		inline let  get_expression_from_code();
@@ -117,80 +137,325 @@ namespace Olly {
 
 	const size_type evaluator::DEFAULT_STACK_LIMIT = 2048;
 
-	evaluator::evaluator() : _variables(), _stack(), _code(), _max_stack_size(DEFAULT_STACK_LIMIT) {
+	evaluator::evaluator(bool_type use_arena) 
+		: _variables(), _stack(), _code(), _blocks(), _slots(), _max_stack_size(DEFAULT_STACK_LIMIT), _steps(0), _arena(nullptr) {
+
+		if (use_arena) {
+			_arena = new arena();
+		}
+	}
+
+	evaluator::~evaluator() {
+		/*
+			The values held by the evaluator are released after this,
+			so the arena is released rather than deleted.
+		*/
+
+		if (_arena) {
+			_arena->release();
+		}
+	}
+
+	inline size_type evaluator::steps() const {
+		return _steps;
+	}
+
+	inline allocation_stats evaluator::allocations() const {
+
+		if (_arena) {
+			return _arena->stats();
+		}
+
+		return object_pool::stats();
 	}
 
 	inline let evaluator::eval(let exp) {
 
-		if (exp.type() != "expression") {
+		if (exp.kind() != TYPE_KIND::EXPRESSION_TYPE) {
 			return nothing();
 		}
-		
-		prep_code_to_execute(exp);
 
-		_code.emplace_back(exp);
+		let result;
+
+		{
+			allocator_scope scope(_arena);
+
+			prep_code_to_execute(exp);
+
+			_code.emplace_back(std::move(exp));
+
+			define_enclosure();
 
-		define_enclosure();
+			eval();
 
-		eval();
+			result = get_result_stack();
+		}
 
-		return get_result_stack();
+		return copy_from_arena(result);
 	}
 
 	inline let Olly::evaluator::eval(let exp, closure_type& vars) {
-		
-		if (exp.type() != "expression") {
+
+		if (exp.kind() != TYPE_KIND::EXPRESSION_TYPE) {
 			return nothing();
 		}
 
-		_code.emplace_back(exp);
+		let result;
+
+		{
+			allocator_scope scope(_arena);
 
-		define_enclosure(vars);
+			_code.emplace_back(std::move(exp));
 
-		eval();
+			define_enclosure(vars);
+
+			eval();
+
+			result = get_result_stack();
+		}
 
-		return get_result_stack();
+		return copy_from_arena(result);
 	}
 
 	inline let Olly::evaluator::get_result_stack() const {
 
 		if (!_stack.empty()) {
 			
-			let result = expression();
+			_vector_builder_ result;
 
-			for (auto i = _stack.crbegin(); i != _stack.crend(); ++i) {
+			for (auto i = _stack.cbegin(); i != _stack.cend(); ++i) {
 
-				result = result.place_lead(*i);
+				result.place_last(*i);
 			}
 
-			return result;
+			return expression(result.persistent());
 		}
 
 		return expression();
 	}
 
+	inline let Olly::evaluator::copy_from_arena(const let& value) const {
+		/*
+			The values of the arena may only be released upon this
+			thread, and keep its blocks in use.  So each object of
+			the arena within the result is copied, outside of the
+			arena, and no value of the arena outlives the evaluator.
+		*/
+
+		if (!_arena) {
+			return value;
+		}
+
+		return copy_value(value, _arena);
+	}
+
 	inline void Olly::evaluator::prep_code_to_execute(let& exp) const {
 
 		while (exp.is() && exp.size() == 1) {
 
-			if (exp.lead().type() != "expression") {
+			if (exp.lead().kind() != TYPE_KIND::EXPRESSION_TYPE) {
 				break;
 			}
 			exp = exp.lead();
 		}
 	}
 
-	inline let Olly::evaluator::get_symbol(let& var) const {
+	inline const void* Olly::evaluator::block_address(const let& exp) const {
+		/*
+			Expressions are identified by the address of thier shared data.
+		*/
+
+		if (exp.kind() == TYPE_KIND::EXPRESSION_TYPE) {
+			return exp.cast<expression>();
+		}
+
+		if (exp.kind() == TYPE_KIND::STATEMENT_TYPE) {
+			return exp.cast<statement>();
+		}
+
+		return nullptr;
+	}
+
+	inline void Olly::evaluator::compile_blocks(const let& exp) {
+		/*
+			Compile each expression found within the code, including the
+			bodies of any lambdas.  Expressions which can not be compiled
+			are recorded as well, so each is only visited once.
+		*/
+
+		TYPE_KIND kind = exp.kind();
+
+		if (kind == TYPE_KIND::LAMBDA_TYPE) {
+			compile_blocks(exp.last());
+			return;
+		}
+
+		if (kind == TYPE_KIND::LIST_TYPE) {
+
+			const list::list_type& items = exp.cast<list>()->get_list();
+
+			for (size_type i = 0, stop = items.size(); i < stop; i += 1) {
+				compile_blocks(items.at(i));
+			}
+			return;
+		}
+
+		if (kind != TYPE_KIND::EXPRESSION_TYPE && kind != TYPE_KIND::STATEMENT_TYPE) {
+			return;
+		}
+
+		let e = exp;
+
+		prep_code_to_execute(e);
+
+		const void* address = block_address(e);
+
+		if (_blocks.find(address) != _blocks.end()) {
+			return;
+		}
+
+		_blocks.emplace(address, compiler(e).compile());
+
+		while (e.is()) {
+			compile_blocks(pop_lead(e));
+		}
+	}
 
-		str_type symbol_name = str(var);
+	inline bool_type Olly::evaluator::run_block(const let& exp) {
 
-		for (auto i = _variables.crbegin(); i != _variables.crend(); ++i) {
+		auto itr = _blocks.find(block_address(exp));
 
-			auto v_itr = i->find(symbol_name);
+		if (itr == _blocks.end()) {
+			return false;
+		}
+
+		code_block& block = itr->second;
+
+		if (!block.is() || (block.needs_outer() && _code.empty())) {
+			return false;
+		}
+
+		/*
+			Resolve each symbol once, on entry to the block.  Scoping is
+			dynamic, so the address of a symbol can not be fixed ahead of
+			time.  The block must be evaluated by the evaluator if any
+			symbol refers to code rather than data.
+		*/
+
+		_slots.clear();
+
+		for (size_type i = 0, stop = block.symbols().size(); i < stop; i += 1) {
+
+			scope_address addr;
+
+			let val = error("undef_var");
+
+			if (find_symbol(block.symbols()[i].cast<symbol>()->id(), addr)) {
+				val = scope_at(addr).get(addr.slot);
+			}
 
-			if (v_itr != i->end()) {
-				return v_itr->second;
+			while (val.kind() == TYPE_KIND::SYMBOL_TYPE) {
+				val = get_symbol(val);
 			}
+
+			switch (val.kind()) {
+
+				case TYPE_KIND::NOTHING_TYPE:
+				case TYPE_KIND::OP_CALL_TYPE:
+				case TYPE_KIND::EXPRESSION_TYPE:
+				case TYPE_KIND::STATEMENT_TYPE:
+				case TYPE_KIND::LAMBDA_TYPE:
+					return false;
+
+				default:
+					break;
+			}
+
+			_slots.emplace_back(val);
+		}
+
+		for (const instruction& i : block.code()) {
+
+			_steps += 1;
+
+			switch (i.code) {
+
+				case BYTE_CODE::PUSH_CODE:
+					set_expression_on_stack(block.constants()[i.arg]);
+					break;
+
+				case BYTE_CODE::LOAD_CODE:
+					set_expression_on_stack(_slots[i.arg]);
+					break;
+
+				case BYTE_CODE::APPLY_CODE: {
+
+					OP_CODE opr = i.op;
+
+					if (opr < OP_CODE::POSTFIX_UNARY_OPERATORS) {
+						postfix_unary_operators(opr);
+					}
+
+					else if (opr < OP_CODE::POSTFIX_BINARY_OPERATORS) {
+						postfix_binary_operators(opr);
+					}
+
+					else if (opr < OP_CODE::STACK_OPERATORS) {
+						stack_operators(opr);
+					}
+
+					else if (opr == OP_CODE::iterable_op) {
+						set_expression_on_stack(boolean(get_expression_from_stack().iterable()));
+					}
+
+					else if (opr < OP_CODE::SEQUENCE_OPERATORS) {
+						sequence_operators(opr);
+					}
+
+					else {
+						io_operators(opr);
+					}
+				}	break;
+
+				default:
+					break;
+			}
+		}
+
+		return true;
+	}
+
+	inline bool_type Olly::evaluator::find_symbol(size_type id, scope_address& addr) const {
+		/*
+			Search each scope from the innermost outward.
+		*/
+
+		for (size_type depth = 0, stop = _variables.size(); depth < stop; depth += 1) {
+
+			size_type slot = _variables[stop - depth - 1].find(id);
+
+			if (slot != scope::npos) {
+
+				addr.depth = depth;
+				addr.slot  = slot;
+
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	inline const scope& Olly::evaluator::scope_at(const scope_address& addr) const {
+		return _variables[_variables.size() - addr.depth - 1];
+	}
+
+	inline let Olly::evaluator::get_symbol(let& var) const {
+
+		scope_address addr;
+
+		if (find_symbol(symbol_id(var), addr)) {
+			return scope_at(addr).get(addr.slot);
 		}
 
 		return error("undef_var");
@@ -198,15 +463,12 @@ namespace Olly {
 
 	inline void Olly::evaluator::set_symbol(let& var, let& val) {
 
-		while (val.type() == "symbol") {
+		while (val.kind() == TYPE_KIND::SYMBOL_TYPE) {
 			val = get_symbol(val);
 		}
 
 		if (!_variables.empty()) {
-
-			str_type symbol_name = str(var);
-
-			_variables.back()[symbol_name] = val;
+			_variables.back().set(symbol_id(var), val);
 		}
 	}
 
@@ -214,11 +476,11 @@ namespace Olly {
 
 		const lambda* l = lam.cast<lambda>();
 
-		_variables.emplace_back(l->variables());
+		_variables.emplace_back(scope(l->enclosure()));
 	}
 
 	inline void Olly::evaluator::define_enclosure() {
-		_variables.emplace_back(map_type());
+		_variables.emplace_back(scope());
 	}
 
 	inline void Olly::evaluator::define_enclosure(closure_type& vars) {
@@ -231,7 +493,7 @@ namespace Olly {
 		}
 	}
 
-	inline void Olly::evaluator::set_expression_on_code(let exp) {
+	inline void Olly::evaluator::set_expression_on_code(const let& exp) {
 
 		if (!_code.empty()) {
 			_code.back() = _code.back().place_lead(exp);
@@ -242,7 +504,7 @@ namespace Olly {
 
 		if (_stack.size() < _max_stack_size) {
 
-			_stack.emplace_back(exp);
+			_stack.emplace_back(std::move(exp));
 			return;
 		}
 
@@ -255,7 +517,7 @@ namespace Olly {
 
 		if (!_stack.empty()) {
 
-			let val = _stack.back();
+			let val = std::move(_stack.back());
 			_stack.pop_back();
 
 			return val;
@@ -296,46 +558,66 @@ namespace Olly {
 
 		do {
 
+			_steps += 1;
+
 			let exp = get_expression_from_code();
 
 			// print("exp = " + str(exp) + " : " + exp.type());
 
-			while (exp.type() == "symbol") {
-				exp = get_symbol(exp);
+			TYPE_KIND kind = exp.kind();
+
+			while (kind == TYPE_KIND::SYMBOL_TYPE) {
+				exp  = get_symbol(exp);
+				kind = exp.kind();
 			}
 
-			if (exp.type() == "expression"  || exp.type() == "statement") {
+			if (kind == TYPE_KIND::EXPRESSION_TYPE || kind == TYPE_KIND::STATEMENT_TYPE) {
 
 				prep_code_to_execute(exp);
 
-				if (!expression_is_empty(exp)) {
-					_code.emplace_back(exp);
+				if (!expression_is_empty(exp) && !run_block(exp)) {
+					_code.emplace_back(std::move(exp));
 				}
 			}
 
-			else if (exp.type() == "lambda") {
+			else if (kind == TYPE_KIND::LAMBDA_TYPE) {
 
 				let args = exp.lead();
 				let body = exp.last();
 
 				define_enclosure(exp);
 
+				compile_blocks(body);
+
 				while (args.is()) {
 
 					let var = pop_lead(args);
 					let val = get_expression_from_code();
 
-					if (var.type() == "symbol") {
+					if (var.kind() == TYPE_KIND::SYMBOL_TYPE) {
 						set_symbol(var, val);
 					}
 				}
 
-				set_expression_on_code(op_call(OP_CODE::end_scope_op));
+				if (peek_expression_from_code().op_code() == OP_CODE::end_scope_op && _variables.size() > 2) {
+					/*
+						A call in tail position.  The caller's scope is replaced
+						rather than kept, and its end of scope is reused.
+					*/
+					scope frame = _variables.back().replace(_variables[_variables.size() - 2]);
+
+					_variables.pop_back();
+					_variables.back() = std::move(frame);
+				}
+				else {
+					set_expression_on_code(op_call_value(OP_CODE::end_scope_op));
+				}
+
 				set_expression_on_code(body);
 			}
 
-			else if (exp.type() != "op_call"  && !exp.is_nothing()) {
-				set_expression_on_stack(exp);
+			else if (kind != TYPE_KIND::OP_CALL_TYPE && kind != TYPE_KIND::NOTHING_TYPE) {
+				set_expression_on_stack(std::move(exp));
 			}
 
 			else {
@@ -384,16 +666,16 @@ namespace Olly {
 	inline void Olly::evaluator::prefix_unary_operators(OP_CODE& opr) {
 
 		let  x = get_expression_from_code();
-		let op;
+		OP_CODE op = OP_CODE::NOTHING_OP;
 
 		switch (opr) {
 
 		case OP_CODE::neg_op:
-			op = op_call(OP_CODE::NEG_op);
+			op = OP_CODE::NEG_op;
 			break;
 
 		case OP_CODE::not_op:
-			op = op_call(OP_CODE::NOT_op);
+			op = OP_CODE::NOT_op;
 			break;
 
 		default:
@@ -401,7 +683,7 @@ namespace Olly {
 		}
 
 		let exp = expression();
-		exp = exp.place_lead(op);
+		exp = exp.place_lead(op_call_value(op));
 		exp = exp.place_lead(x);
 
 		set_expression_on_code(exp);
@@ -430,97 +712,97 @@ namespace Olly {
 			break;
 		}
 
-		set_expression_on_stack(y);
+		set_expression_on_stack(std::move(y));
 	}
 
 	inline void Olly::evaluator::infix_binary_operators(OP_CODE& opr) {
 
 		let  x = get_expression_from_code();
-		let op;
+		OP_CODE op = OP_CODE::NOTHING_OP;
 
 		switch (opr) {
 
 			/**** Logical Operators ****/
 
 		case OP_CODE::and_op:
-			op = op_call(OP_CODE::AND_op);
+			op = OP_CODE::AND_op;
 			break;
 
 		case OP_CODE::or_op:
-			op = op_call(OP_CODE::OR_op);
+			op = OP_CODE::OR_op;
 			break;
 
 		case OP_CODE::xor_op:
-			op = op_call(OP_CODE::XOR_op);
+			op = OP_CODE::XOR_op;
 			break;
 
 
 			/**** Comparision Operations ****/
 
 		case OP_CODE::eq_op:
-			op = op_call(OP_CODE::EQ_op);
+			op = OP_CODE::EQ_op;
 			break;
 
 		case OP_CODE::ne_op:
-			op = op_call(OP_CODE::NE_op);
+			op = OP_CODE::NE_op;
 			break;
 
 		case OP_CODE::lt_op:
-			op = op_call(OP_CODE::LT_op);
+			op = OP_CODE::LT_op;
 			break;
 
 		case OP_CODE::le_op:
-			op = op_call(OP_CODE::LE_op);
+			op = OP_CODE::LE_op;
 			break;
 
 		case OP_CODE::gt_op:
-			op = op_call(OP_CODE::GT_op);
+			op = OP_CODE::GT_op;
 			break;
 
 		case OP_CODE::ge_op:
-			op = op_call(OP_CODE::GE_op);
+			op = OP_CODE::GE_op;
 			break;
 
 
 			/**** Base Mathmatical Operations ****/
 
 		case OP_CODE::add_op:
-			op = op_call(OP_CODE::ADD_op);
+			op = OP_CODE::ADD_op;
 			break;
 
 		case OP_CODE::sub_op:
-			op = op_call(OP_CODE::SUB_op);
+			op = OP_CODE::SUB_op;
 			break;
 
 		case OP_CODE::mul_op:
-			op = op_call(OP_CODE::MUL_op);
+			op = OP_CODE::MUL_op;
 			break;
 
 		case OP_CODE::div_op:
-			op = op_call(OP_CODE::DIV_op);
+			op = OP_CODE::DIV_op;
 			break;
 
 		case OP_CODE::mod_op:
-			op = op_call(OP_CODE::MOD_op);
+			op = OP_CODE::MOD_op;
 			break;
 
 		case OP_CODE::fdiv_op:
-			op = op_call(OP_CODE::FDIV_op);
+			op = OP_CODE::FDIV_op;
 			break;
 
 		case OP_CODE::rem_op:
-			op = op_call(OP_CODE::REM_op);
+			op = OP_CODE::REM_op;
 			break;
 
 		case OP_CODE::pow_op:
-			op = op_call(OP_CODE::POW_op);
+			op = OP_CODE::POW_op;
 			break;
 
 		default:
 			break;
 		}
 
-		set_expression_on_code(op);
+		set_expression_on_code(op_call_value(op));
 		set_expression_on_code(x);
 	}
 
@@ -613,7 +895,7 @@ namespace Olly {
 			break;
 		}
 
-		set_expression_on_stack(z);
+		set_expression_on_stack(std::move(z));
 	}
 
 	inline void Olly::evaluator::stack_operators(OP_CODE& opr) {
@@ -622,13 +904,13 @@ namespace Olly {
 
 			case OP_CODE::STACK_op: {
 
-				let result = expression();
+				_vector_builder_ result;
 
-				for (auto i = _stack.cbegin(); i != _stack.cend(); ++i) {
+				for (auto i = _stack.crbegin(); i != _stack.crend(); ++i) {
 
-					result = result.place_lead(*i);
+					result.place_last(*i);
 				}
-				_stack.emplace_back(result);
+				_stack.emplace_back(expression(result.persistent()));
 			} break;
 
 			case OP_CODE::DEPTH_op: {
@@ -643,7 +925,7 @@ namespace Olly {
 
 				let new_stack = get_expression_from_code();
 
-				while (new_stack.type() == "symbol") {
+				while (new_stack.kind() == TYPE_KIND::SYMBOL_TYPE) {
 					new_stack = get_symbol(new_stack);
 				}
 
@@ -674,7 +956,7 @@ namespace Olly {
 
 				const lambda* l = val.cast<lambda>();
 
-				if (var.type() == "symbol") {
+				if (var.kind() == TYPE_KIND::SYMBOL_TYPE) {
 					set_symbol(var, val);
 				}
 			}	break;
@@ -687,7 +969,7 @@ namespace Olly {
 
 				if (oper.op_code() == OP_CODE::eq_op) {
 
-					if (vars.type() != "expression") {
+					if (vars.kind() != TYPE_KIND::EXPRESSION_TYPE) {
 
 						vars = expression(vars);
 						vals = expression(vals);
@@ -698,14 +980,14 @@ namespace Olly {
 						let var = pop_lead(vars);
 						let val = pop_lead(vals);
 
-						if (val.type() == "lambda") {
+						if (val.kind() == TYPE_KIND::LAMBDA_TYPE) {
 							set_symbol(var, val);
 
 						}
 
 						else {
 							set_expression_on_code(var);
-							set_expression_on_code(op_call(OP_CODE::LET_op));
+							set_expression_on_code(op_call_value(OP_CODE::LET_op));
 							set_expression_on_code(val);
 						}
 					}
@@ -725,9 +1007,7 @@ namespace Olly {
 						Ignore global scope for the purpose of setting the values of the enclosure.  
 						Get the current scope and bind it to the defined function.
 					*/
-					auto enc = _variables.back();
-
-					lam.bind_scope(enc);
+					lam.bind_scope(_variables.back());
 				}
 
 				lam.bind_variable(var, lam);  // Provide a self reference for recursion.  
@@ -735,9 +1015,9 @@ namespace Olly {
 				lam.bind_variable(string("self"), var);  // Identify the self refrence.  
 
 				set_expression_on_code(lam);
-				set_expression_on_code(op_call(OP_CODE::eq_op));
+				set_expression_on_code(op_call_value(OP_CODE::eq_op));
 				set_expression_on_code(var);
-				set_expression_on_code(op_call(OP_CODE::let_op));
+				set_expression_on_code(op_call_value(OP_CODE::let_op));
 			}	break;
 
 			case OP_CODE::bind_op: {  // Bind variables or constants to an enclosure.
@@ -748,11 +1028,11 @@ namespace Olly {
 
 				let function_name = lamb;
 
-				while (lamb.type() == "symbol") {
+				while (lamb.kind() == TYPE_KIND::SYMBOL_TYPE) {
 					lamb = get_symbol(lamb);
 				}
 
-				if (lamb.type() == "lambda") {
+				if (lamb.kind() == TYPE_KIND::LAMBDA_TYPE) {
 
 					OP_CODE op = oper.op_code();
 
@@ -763,7 +1043,7 @@ namespace Olly {
 						let arg = pop_lead(args);
 						let val = get_symbol(arg);
 
-						while (val.type() == "symbol") {
+						while (val.kind() == TYPE_KIND::SYMBOL_TYPE) {
 							val = get_symbol(val);
 						}
 
@@ -781,7 +1061,7 @@ namespace Olly {
 
 				let args = get_expression_from_code();
 
-				if (args.type() != "expression") {
+				if (args.kind() != TYPE_KIND::EXPRESSION_TYPE) {
 					args = expression(args);
 				}
 
@@ -791,14 +1071,14 @@ namespace Olly {
 
 					let a = pop_lead(args);
 
-					while (a.type() == "symbol") {
+					while (a.kind() == TYPE_KIND::SYMBOL_TYPE) {
 						a = get_symbol(a);
 					}
 
 					queue = queue.place_lead(a);
 				}
 
-				let end = op_call(OP_CODE::end_scope_op);
+				const let& end = op_call_value(OP_CODE::end_scope_op);
 				let itr = get_expression_from_code();
 
 				while (end != itr) {
@@ -815,15 +1095,52 @@ namespace Olly {
 
 			} break;
 
+			case OP_CODE::loop_op: {  // Evaluate an expression for as long as a condition holds.
+
+				let cond = get_expression_from_code();
+				let body = get_expression_from_code();
+
+				let loop = expression(cond, body);
+
+				let frame = expression();
+
+				frame = frame.place_lead(loop);
+				frame = frame.place_lead(op_call_value(OP_CODE::LOOP_op));
+				frame = frame.place_lead(cond);
+
+				_code.emplace_back(std::move(frame));
+			}	break;
+
+			case OP_CODE::LOOP_op: {  // Test the condition, and if it holds evaluate the body then test again.
+
+				let truth = get_expression_from_stack();
+				let loop  = get_expression_from_code();
+
+				if (truth.is()) {
+					/*
+						The frame holding this operator is spent, so each pass
+						replaces it with another and the code does not grow.
+					*/
+					let frame = expression();
+
+					frame = frame.place_lead(loop);
+					frame = frame.place_lead(op_call_value(OP_CODE::LOOP_op));
+					frame = frame.place_lead(loop.lead());
+					frame = frame.place_lead(loop.last());
+
+					_code.emplace_back(std::move(frame));
+				}
+			}	break;
+
 			case OP_CODE::relent_op: { // Place the next expression on to the stack without evaluation.  
 
 				let arg = get_expression_from_code();
 
-				while (arg.type() == "symbol") {
+				while (arg.kind() == TYPE_KIND::SYMBOL_TYPE) {
 					arg = get_symbol(arg);
 				}
 
-				set_expression_on_stack(arg);
+				set_expression_on_stack(std::move(arg));
 			} break;
 
 			default:
@@ -840,13 +1157,13 @@ namespace Olly {
 				let s = get_expression_from_stack();
 				let r = number(s.size());
 
-				set_expression_on_stack(r);
+				set_expression_on_stack(std::move(r));
 			} break;
 
 			case OP_CODE::len_op: {
 
 				let s = get_expression_from_code();
-				let o = op_call(OP_CODE::LEN_op);
+				const let& o = op_call_value(OP_CODE::LEN_op);
 
 				set_expression_on_code(o);
 				set_expression_on_code(s);
@@ -857,13 +1174,13 @@ namespace Olly {
 				let s = get_expression_from_stack();
 				let r = s.lead();
 
-				set_expression_on_stack(r);
+				set_expression_on_stack(std::move(r));
 			} break;
 
 			case OP_CODE::lead_op: {
 
 				let s = get_expression_from_code();
-				let o = op_call(OP_CODE::LEAD_op);
+				const let& o = op_call_value(OP_CODE::LEAD_op);
 
 				set_expression_on_code(o);
 				set_expression_on_code(s);
@@ -874,13 +1191,13 @@ namespace Olly {
 				let s = get_expression_from_stack();
 				let r = s.last();
 
-				set_expression_on_stack(r);
+				set_expression_on_stack(std::move(r));
 			} break;
 
 			case OP_CODE::last_op: {
 
 				let s = get_expression_from_code();
-				let o = op_call(OP_CODE::LAST_op);
+				const let& o = op_call_value(OP_CODE::LAST_op);
 
 				set_expression_on_code(o);
 				set_expression_on_code(s);
@@ -892,13 +1209,13 @@ namespace Olly {
 				let n = get_expression_from_stack();
 				let r = l.place_lead(n);
 
-				set_expression_on_stack(r);
+				set_expression_on_stack(std::move(r));
 			} break;
 
 			case OP_CODE::place_lead_op: {
 
 				let s = get_expression_from_code();
-				let o = op_call(OP_CODE::PLACE_LEAD_op);
+				const let& o = op_call_value(OP_CODE::PLACE_LEAD_op);
 
 				set_expression_on_code(o);
 				set_expression_on_code(s);
@@ -910,13 +1227,13 @@ namespace Olly {
 				let l = get_expression_from_stack();
 				let r = l.place_last(n);
 
-				set_expression_on_stack(r);
+				set_expression_on_stack(std::move(r));
 			} break;
 
 			case OP_CODE::place_last_op: {
 
 				let s = get_expression_from_code();
-				let o = op_call(OP_CODE::PLACE_LAST_op);
+				const let& o = op_call_value(OP_CODE::PLACE_LAST_op);
 
 				set_expression_on_code(o);
 				set_expression_on_code(s);
@@ -932,7 +1249,7 @@ namespace Olly {
 			case OP_CODE::shift_lead_op: {
 
 				let s = get_expression_from_code();
-				let o = op_call(OP_CODE::SHIFT_LEAD_op);
+				const let& o = op_call_value(OP_CODE::SHIFT_LEAD_op);
 
 				set_expression_on_code(o);
 				set_expression_on_code(s);
@@ -947,7 +1264,7 @@ namespace Olly {
 
 			case OP_CODE::shift_last_op: {
 
-				let o = op_call(OP_CODE::SHIFT_LAST_op);
+				const let& o = op_call_value(OP_CODE::SHIFT_LAST_op);
 
 				set_expression_on_code(o);
 			} break;
@@ -968,7 +1285,7 @@ namespace Olly {
 
 				index = object.get(index);
 
-				set_expression_on_stack(index);
+				set_expression_on_stack(std::move(index));
 			} break;
 
 			case OP_CODE::SET_op: {
@@ -979,7 +1296,7 @@ namespace Olly {
 
 				index = object.set(index, value);
 
-				set_expression_on_stack(index);
+				set_expression_on_stack(std::move(index));
 			} break;
 
 			case OP_CODE::index_op: {
@@ -993,19 +1310,19 @@ namespace Olly {
 					auto length = l->get_list().size();
 
 					if (length == 1) {
-						let op = op_call(OP_CODE::GET_op);
+						const let& op = op_call_value(OP_CODE::GET_op);
 
 						set_expression_on_code(op);
-						set_expression_on_code(l->get_list()[0]);
+						set_expression_on_code(l->get_list().at(0));
 					}
 
-					else if (length == 3 && l->get_list()[1].op_code() == OP_CODE::eq_op) {
+					else if (length == 3 && l->get_list().at(1).op_code() == OP_CODE::eq_op) {
 
-						let op = op_call(OP_CODE::SET_op);
+						const let& op = op_call_value(OP_CODE::SET_op);
 
 						set_expression_on_code(op);
-						set_expression_on_code(l->get_list().back());
-						set_expression_on_code(l->get_list().front());
+						set_expression_on_code(l->get_list().last());
+						set_expression_on_code(l->get_list().lead());
 					}
 				}
 			} break;
@@ -1058,9 +1375,9 @@ namespace Olly {
 			case OP_CODE::cond_op: {    // Conditional logical implications.
 				let conditions = get_expression_from_code();
 
-				if (conditions.type() == "expression") {
+				if (conditions.kind() == TYPE_KIND::EXPRESSION_TYPE) {
 
-					if (conditions.lead().type() == "op_call") {
+					if (conditions.lead().kind() == TYPE_KIND::OP_CALL_TYPE) {
 						conditions = conditions.shift_lead();
 					}
 
@@ -1072,7 +1389,7 @@ namespace Olly {
 						let p = pop_lead(conditions);
 						let q = pop_lead(conditions);
 
-						if (q.type() == "expression") {
+						if (q.kind() == TYPE_KIND::EXPRESSION_TYPE) {
 
 							props = props.place_lead(p);
 							quots = quots.place_lead(q);
@@ -1085,8 +1402,8 @@ namespace Olly {
 					if (props.is()) {
 
 						let exp       = expression();
-						let impl_oper = op_call(OP_CODE::imply_op);
-						let else_oper = op_call(OP_CODE::else_op);
+						const let& impl_oper = op_call_value(OP_CODE::imply_op);
+						const let& else_oper = op_call_value(OP_CODE::else_op);
 
 						exp = exp.place_lead(expression());
 						exp = exp.place_lead(else_oper);
@@ -1114,39 +1431,21 @@ namespace Olly {
 
 			}	break;
 
-			case OP_CODE::loop_op: {
-
-				let p = get_expression_from_code();
-				let q = get_expression_from_code();
-
-				_code.emplace_back(expression());
-
-				set_expression_on_code(q);
-				set_expression_on_code(p);
-				set_expression_on_code(op_call(OP_CODE::loop_op));
-				set_expression_on_code(op_call(OP_CODE::END_op));
-				set_expression_on_code(op_call(OP_CODE::else_op));
-				set_expression_on_code(q);
-				set_expression_on_code(op_call(OP_CODE::imply_op));
-				set_expression_on_code(p);
-
-			}	break;
-
 			case OP_CODE::is_const_op: {   // Postfix is constant.
 				let x = get_expression_from_code();
 
 				let truth = boolean(false);
 
-				if (x.type() == "symbol") {
+				if (x.kind() == TYPE_KIND::SYMBOL_TYPE) {
 
 					str_type symbol_name = to_upper(repr(x));
 				}
 
-				if (x.type() == "op_call") {
+				if (x.kind() == TYPE_KIND::OP_CALL_TYPE) {
 					truth = boolean(true);
 				}
 
-				set_expression_on_stack(truth);
+				set_expression_on_stack(std::move(truth));
 			}	break;
 
 			case OP_CODE::is_var_op: {   // Postfix is variable.
@@ -1154,21 +1453,16 @@ namespace Olly {
 
 				let truth = boolean(false);
 
-				if (x.type() == "symbol") {
-
-					str_type symbol_name = repr(x);
+				if (x.kind() == TYPE_KIND::SYMBOL_TYPE) {
 
-					for (auto i = _variables.crbegin(); i != _variables.crend(); ++i) {
+					scope_address addr;
 
-						auto v_itr = i->find(symbol_name);
-
-						if (v_itr != i->end()) {
-							truth = boolean(true);
-						}
+					if (find_symbol(symbol_id(x), addr)) {
+						truth = boolean(true);
 					}
 				}
 
-				set_expression_on_stack(truth);
+				set_expression_on_stack(std::move(truth));
 			}	break;
 
 			default:
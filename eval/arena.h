@@ -0,0 +1,198 @@
+#pragma once
+
+/********************************************************************************************/
+//
+//			Copyright 2019 Max J. Martin
+//
+//			This file is part of Oliver.
+//
+//			Oliver is free software : you can redistribute it and / or modify
+//			it under the terms of the GNU General Public License as published by
+//			the Free Software Foundation, either version 3 of the License, or
+//			(at your option) any later version.
+//
+//			Oliver is distributed in the hope that it will be useful,
+//			but WITHOUT ANY WARRANTY; without even the implied warranty of
+//			MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//			GNU General Public License for more details.
+//
+//			You should have received a copy of the GNU General Public License
+//			along with Oliver.If not, see < https://www.gnu.org/licenses/>.
+//
+/********************************************************************************************/
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "..\let.h"
+
+namespace Olly {
+
+	/********************************************************************************************/
+	//
+	//                                  'arena' Class Definition
+	//
+	//          The arena class is a let_allocator for the values of a single evaluator.
+	//          Memory is cut from large blocks, and an object returned to the arena is
+	//          kept on a free list for its size, to be reused by the next object of that
+	//          size.  So the values of a run seldom reach the heap, and the blocks are
+	//          all freed together when the arena is done.  Objects too large to pool
+	//          are taken from the heap directly.
+	//
+	//          The values of the arena are confined to the thread of its evaluator,
+	//          so the arena takes no locks.  The evaluator copies its result out of
+	//          the arena, so no value of the arena escapes it.  The values held by the
+	//          evaluator are still released after its destructor has run, so the owner
+	//          releases the arena rather than deleting it, and the arena deletes itself
+	//          once the last of its objects has been returned.
+	//
+	/********************************************************************************************/
+
+	class arena : public let_allocator {
+
+		static const size_type BLOCK_SIZE = 1 << 16;
+		static const size_type GRAIN      = alignof(std::max_align_t);
+		static const size_type CLASSES    = 32;                           // Objects up to GRAIN * CLASSES bytes are pooled.
+
+		struct _free_ {
+			_free_* _next;
+		};
+
+		std::vector<char*>        _blocks;
+		char*                       _next;    // The unused remainder of the newest block.
+		char*                        _end;
+		_free_*           _free[CLASSES];
+		size_type                   _live;    // The objects not yet returned.
+		bool_type               _released;    // Has the owner let go of the arena.
+		allocation_stats           _stats;
+
+	public:
+
+		arena();
+
+		void*        allocate(size_type bytes);
+		void       deallocate(void* p, size_type bytes);
+
+		void          release();                                             // Delete the arena once each object is returned.
+
+		const allocation_stats& stats()                                const;
+
+	private:
+
+		virtual ~arena();
+
+		arena(const arena& obj) = delete;
+
+		static size_type size_class(size_type bytes);
+	};
+
+	/********************************************************************************************/
+	//
+	//                                 'arena' Class Implimentation
+	//
+	/********************************************************************************************/
+
+	arena::arena() : _blocks(), _next(nullptr), _end(nullptr), _free(), _live(0), _released(false), _stats() {
+	}
+
+	arena::~arena() {
+
+		for (char* block : _blocks) {
+			::operator delete(block);
+		}
+	}
+
+	void* arena::allocate(size_type bytes) {
+
+		size_type n = size_class(bytes);
+
+		_stats.allocations += 1;
+		_stats.bytes       += bytes;
+		_stats.live_bytes  += bytes;
+
+		if (_stats.live_bytes > _stats.peak_bytes) {
+			_stats.peak_bytes = _stats.live_bytes;
+		}
+
+		_live += 1;
+
+		if (n >= CLASSES) {
+
+			_stats.heap += 1;
+
+			return ::operator new(bytes);
+		}
+
+		if (_free[n]) {
+
+			_free_* p = _free[n];
+
+			_free[n] = p->_next;
+
+			return p;
+		}
+
+		size_type size = (n + 1) * GRAIN;
+
+		if (static_cast<size_type>(_end - _next) < size) {
+
+			_next = static_cast<char*>(::operator new(BLOCK_SIZE));
+			_end  = _next + BLOCK_SIZE;
+
+			_blocks.push_back(_next);
+
+			_stats.blocks += 1;
+		}
+
+		void* p = _next;
+
+		_next += size;
+
+		return p;
+	}
+
+	void arena::deallocate(void* p, size_type bytes) {
+
+		size_type n = size_class(bytes);
+
+		_stats.deallocations += 1;
+		_stats.live_bytes    -= bytes;
+
+		if (n >= CLASSES) {
+			::operator delete(p);
+		}
+		else {
+			_free[n] = new (p) _free_{ _free[n] };
+		}
+
+		_live -= 1;
+
+		if (_released && !_live) {
+			delete this;
+		}
+	}
+
+	void arena::release() {
+
+		_released = true;
+
+		if (!_live) {
+			delete this;
+		}
+	}
+
+	const allocation_stats& arena::stats() const {
+		return _stats;
+	}
+
+	size_type arena::size_class(size_type bytes) {
+		/*
+			Objects are pooled in multiples of the grain, so
+			each stays aligned for any type.
+		*/
+
+		return bytes ? (bytes - 1) / GRAIN : 0;
+	}
+
+} // end
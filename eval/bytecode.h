@@ -0,0 +1,462 @@
+#pragma once
+
+/********************************************************************************************/
+//
+//			Copyright 2019 Max J. Martin
+//
+//			This file is part of Oliver.
+//
+//			Oliver is free software : you can redistribute it and / or modify
+//			it under the terms of the GNU General Public License as published by
+//			the Free Software Foundation, either version 3 of the License, or
+//			(at your option) any later version.
+//
+//			Oliver is distributed in the hope that it will be useful,
+//			but WITHOUT ANY WARRANTY; without even the implied warranty of
+//			MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//			GNU General Public License for more details.
+//
+//			You should have received a copy of the GNU General Public License
+//			along with Oliver.If not, see < https://www.gnu.org/licenses/>.
+//
+/********************************************************************************************/
+
+#include <algorithm>
+#include <vector>
+
+#include "types_header.h"
+
+namespace Olly {
+
+	/********************************************************************************************/
+	//
+	//			                       Byte Code Instruction ENUM
+	//
+	//          A compiled block is a flat array of instructions.  Each instruction
+	//          either pushes a constant, pushes the value of a symbol slot, or
+	//          applies one of the postfix operators defined by OP_CODE.
+	//
+	/********************************************************************************************/
+
+	enum class BYTE_CODE {
+		NOTHING_CODE = 0, PUSH_CODE, LOAD_CODE, APPLY_CODE
+	};
+
+	struct instruction {
+		BYTE_CODE  code;
+		OP_CODE      op;
+		size_type   arg;
+	};
+
+	/********************************************************************************************/
+	//
+	//                                'code_block' Class Definition
+	//
+	//          The code_block class holds the result of compiling a single
+	//          expression.  Infix and prefix operators have been rewritten as
+	//          postfix, constants are held in a pool, and each distinct symbol
+	//          is given a slot which is resolved once when the block is entered.
+	//
+	/********************************************************************************************/
+
+	class code_block {
+
+		typedef std::vector<instruction>      code_type;
+		typedef std::vector<let>              pool_type;
+
+		let          _source;       // The expression compiled, held so its address remains unique.
+		code_type    _code;
+		pool_type    _constants;
+		pool_type    _symbols;
+		bool_type    _is;
+		bool_type    _needs_outer;  // An operator rewrite spilled onto the enclosing code.
+
+		friend class compiler;
+
+	public:
+
+		code_block();
+		code_block(const let& source);
+
+		bool_type                    is()                         const;  // Was the expression able to be compiled.
+		bool_type           needs_outer()                         const;
+
+		const let&               source()                         const;
+		const code_type&           code()                         const;
+		const pool_type&      constants()                         const;
+		const pool_type&        symbols()                         const;
+	};
+
+	/********************************************************************************************/
+	//
+	//                                 'compiler' Class Definition
+	//
+	//          The compiler class lowers an expression into a code_block.  It
+	//          performs the same rewriting of the code stream as the evaluator,
+	//          but once and ahead of time.  Only expressions made entirely of
+	//          data, symbols, nested expressions and operators which neither
+	//          bind variables nor consume code at run time can be compiled.
+	//          Anything else is left to the evaluator.
+	//
+	/********************************************************************************************/
+
+	class compiler {
+
+		typedef std::vector<let>   queue_type;
+
+		code_block   _block;
+		queue_type   _queue;    // The items yet to be compiled, with the next item held last.
+
+	public:
+
+		compiler(const let& exp);
+
+		code_block compile();
+
+	private:
+
+		bool_type  compile_item(let& item);
+		bool_type  compile_operator(OP_CODE opr);
+
+		bool_type  rewrite_operand(OP_CODE opr);
+		OP_CODE       postfix_form(OP_CODE opr)  const;
+		void       place_on_queue(const let& item);
+		void       place_on_queue(const let& a, const let& b);
+		void       place_expression(const let& exp);
+
+		void       emit(BYTE_CODE code, OP_CODE op, size_type arg);
+		size_type  symbol_slot(const let& var);
+	};
+
+	/********************************************************************************************/
+	//
+	//                               'code_block' Class Implimentation
+	//
+	/********************************************************************************************/
+
+	code_block::code_block() : _source(), _code(), _constants(), _symbols(), _is(false), _needs_outer(false) {
+	}
+
+	code_block::code_block(const let& source) : _source(source), _code(), _constants(), _symbols(), _is(false), _needs_outer(false) {
+	}
+
+	bool_type code_block::is() const {
+		return _is;
+	}
+
+	bool_type code_block::needs_outer() const {
+		return _needs_outer;
+	}
+
+	const let& code_block::source() const {
+		return _source;
+	}
+
+	const code_block::code_type& code_block::code() const {
+		return _code;
+	}
+
+	const code_block::pool_type& code_block::constants() const {
+		return _constants;
+	}
+
+	const code_block::pool_type& code_block::symbols() const {
+		return _symbols;
+	}
+
+	/********************************************************************************************/
+	//
+	//                                'compiler' Class Implimentation
+	//
+	/********************************************************************************************/
+
+	compiler::compiler(const let& exp) : _block(exp), _queue() {
+	}
+
+	code_block compiler::compile() {
+
+		place_expression(_block._source);
+
+		while (!_queue.empty()) {
+
+			let item = std::move(_queue.back());
+			_queue.pop_back();
+
+			if (!compile_item(item)) {
+				return code_block(_block._source);
+			}
+		}
+
+		_block._is = true;
+
+		return std::move(_block);
+	}
+
+	bool_type compiler::compile_item(let& item) {
+
+		switch (item.kind()) {
+
+			case TYPE_KIND::SYMBOL_TYPE:
+				emit(BYTE_CODE::LOAD_CODE, OP_CODE::NOTHING_OP, symbol_slot(item));
+				return true;
+
+			case TYPE_KIND::EXPRESSION_TYPE:
+			case TYPE_KIND::STATEMENT_TYPE:
+				place_expression(item);
+				return true;
+
+			case TYPE_KIND::LAMBDA_TYPE:
+				return false;
+
+			case TYPE_KIND::NOTHING_TYPE:
+				return true;
+
+			case TYPE_KIND::OP_CALL_TYPE:
+				return compile_operator(item.op_code());
+
+			default:
+				break;
+		}
+
+		emit(BYTE_CODE::PUSH_CODE, OP_CODE::NOTHING_OP, _block._constants.size());
+
+		_block._constants.emplace_back(item);
+
+		return true;
+	}
+
+	bool_type compiler::compile_operator(OP_CODE opr) {
+
+		if (opr <= OP_CODE::NOTHING_OP || opr >= OP_CODE::IO_OPERATORS) {
+			/*
+				The evaluator takes no action for these operators.
+			*/
+			return true;
+		}
+
+		switch (opr) {
+
+			/**** Operators Rewritten As Postfix ****/
+
+			case OP_CODE::neg_op:
+			case OP_CODE::not_op:
+				return rewrite_operand(postfix_form(opr));
+
+			case OP_CODE::len_op:
+			case OP_CODE::lead_op:
+			case OP_CODE::last_op:
+			case OP_CODE::place_lead_op:
+			case OP_CODE::place_last_op:
+			case OP_CODE::shift_lead_op:
+				return rewrite_operand(postfix_form(opr));
+
+			case OP_CODE::shift_last_op:
+				place_on_queue(op_call_value(OP_CODE::SHIFT_LAST_op));
+				return true;
+
+			case OP_CODE::index_op: {
+
+				if (_queue.empty()) {
+					return false;
+				}
+
+				let index = std::move(_queue.back());
+				_queue.pop_back();
+
+				const list* l = index.cast<list>();
+
+				if (l) {
+
+					auto length = l->get_list().size();
+
+					if (length == 1) {
+						place_on_queue(l->get_list().at(0), op_call_value(OP_CODE::GET_op));
+					}
+
+					else if (length == 3 && l->get_list().at(1).op_code() == OP_CODE::eq_op) {
+
+						place_on_queue(l->get_list().last(), op_call_value(OP_CODE::SET_op));
+						place_on_queue(l->get_list().lead());
+					}
+				}
+			}	return true;
+
+			/**** Operators Applied Directly ****/
+
+			case OP_CODE::IS_op:
+			case OP_CODE::NEG_op:
+			case OP_CODE::NOT_op:
+			case OP_CODE::STACK_op:
+			case OP_CODE::DEPTH_op:
+			case OP_CODE::MAX_DEPTH_op:
+			case OP_CODE::LEN_op:
+			case OP_CODE::LEAD_op:
+			case OP_CODE::LAST_op:
+			case OP_CODE::PLACE_LEAD_op:
+			case OP_CODE::PLACE_LAST_op:
+			case OP_CODE::SHIFT_LEAD_op:
+			case OP_CODE::SHIFT_LAST_op:
+			case OP_CODE::GET_op:
+			case OP_CODE::SET_op:
+			case OP_CODE::PRINT_op:
+				emit(BYTE_CODE::APPLY_CODE, opr, 0);
+				return true;
+
+			case OP_CODE::iterable_op:
+				/*
+					The evaluator places the result back on to the code, so it
+					must be able to reach the enclosing code as well.
+				*/
+				if (_queue.empty()) {
+					_block._needs_outer = true;
+				}
+				emit(BYTE_CODE::APPLY_CODE, opr, 0);
+				return true;
+
+			case OP_CODE::iter_op:
+			case OP_CODE::ITER_op:
+				return true;
+
+			default:
+				break;
+		}
+
+		if (opr > OP_CODE::POSTFIX_UNARY_OPERATORS && opr < OP_CODE::INFIX_BINARY_OPERATORS) {
+			return rewrite_operand(postfix_form(opr));
+		}
+
+		if (opr > OP_CODE::INFIX_BINARY_OPERATORS && opr < OP_CODE::POSTFIX_BINARY_OPERATORS) {
+			emit(BYTE_CODE::APPLY_CODE, opr, 0);
+			return true;
+		}
+
+		return false;
+	}
+
+	bool_type compiler::rewrite_operand(OP_CODE opr) {
+		/*
+			Take the next item as the operand and place it back ahead of the
+			postfix form of the operator.
+		*/
+
+		if (_queue.empty()) {
+			return false;
+		}
+
+		let x = std::move(_queue.back());
+		_queue.pop_back();
+
+		place_on_queue(x, op_call_value(opr));
+
+		return true;
+	}
+
+	OP_CODE compiler::postfix_form(OP_CODE opr) const {
+		/*
+			The postfix operator a prefix or infix operator is rewritten as.
+		*/
+
+		switch (opr) {
+
+			/**** Prefix Unary Operators ****/
+
+			case OP_CODE::neg_op:        return OP_CODE::NEG_op;
+			case OP_CODE::not_op:        return OP_CODE::NOT_op;
+
+			/**** Infix Binary Operators ****/
+
+			case OP_CODE::and_op:        return OP_CODE::AND_op;
+			case OP_CODE::or_op:         return OP_CODE::OR_op;
+			case OP_CODE::xor_op:        return OP_CODE::XOR_op;
+
+			case OP_CODE::eq_op:         return OP_CODE::EQ_op;
+			case OP_CODE::ne_op:         return OP_CODE::NE_op;
+			case OP_CODE::lt_op:         return OP_CODE::LT_op;
+			case OP_CODE::le_op:         return OP_CODE::LE_op;
+			case OP_CODE::gt_op:         return OP_CODE::GT_op;
+			case OP_CODE::ge_op:         return OP_CODE::GE_op;
+
+			case OP_CODE::add_op:        return OP_CODE::ADD_op;
+			case OP_CODE::sub_op:        return OP_CODE::SUB_op;
+			case OP_CODE::mul_op:        return OP_CODE::MUL_op;
+			case OP_CODE::div_op:        return OP_CODE::DIV_op;
+			case OP_CODE::mod_op:        return OP_CODE::MOD_op;
+			case OP_CODE::fdiv_op:       return OP_CODE::FDIV_op;
+			case OP_CODE::rem_op:        return OP_CODE::REM_op;
+			case OP_CODE::pow_op:        return OP_CODE::POW_op;
+
+			/**** Prefix Sequence Operators ****/
+
+			case OP_CODE::len_op:        return OP_CODE::LEN_op;
+			case OP_CODE::lead_op:       return OP_CODE::LEAD_op;
+			case OP_CODE::last_op:       return OP_CODE::LAST_op;
+			case OP_CODE::place_lead_op: return OP_CODE::PLACE_LEAD_op;
+			case OP_CODE::place_last_op: return OP_CODE::PLACE_LAST_op;
+			case OP_CODE::shift_lead_op: return OP_CODE::SHIFT_LEAD_op;
+
+			default:
+				break;
+		}
+
+		return OP_CODE::NOTHING_OP;
+	}
+
+	void compiler::place_on_queue(const let& item) {
+
+		if (_queue.empty()) {
+			_block._needs_outer = true;
+		}
+
+		_queue.emplace_back(item);
+	}
+
+	void compiler::place_on_queue(const let& a, const let& b) {
+
+		if (_queue.empty()) {
+			_block._needs_outer = true;
+		}
+
+		_queue.emplace_back(b);
+		_queue.emplace_back(a);
+	}
+
+	void compiler::place_expression(const let& exp) {
+
+		let e = exp;
+
+		while (e.is() && e.size() == 1) {
+
+			if (e.lead().kind() != TYPE_KIND::EXPRESSION_TYPE) {
+				break;
+			}
+			e = e.lead();
+		}
+
+		size_type start = _queue.size();
+
+		while (e.is()) {
+			_queue.emplace_back(pop_lead(e));
+		}
+
+		std::reverse(_queue.begin() + start, _queue.end());
+	}
+
+	void compiler::emit(BYTE_CODE code, OP_CODE op, size_type arg) {
+		_block._code.emplace_back(instruction{ code, op, arg });
+	}
+
+	size_type compiler::symbol_slot(const let& var) {
+
+		for (size_type i = 0, stop = _block._symbols.size(); i < stop; i += 1) {
+
+			if (_block._symbols[i] == var) {
+				return i;
+			}
+		}
+
+		_block._symbols.emplace_back(var);
+
+		return _block._symbols.size() - 1;
+	}
+
+} // end
@@ -27,6 +27,7 @@
 #include "..\types\error.h"
 #include "..\types\list.h"
 #include "..\types\number.h"
+#include "..\types\set.h"
 #include "..\types\string.h"
 #include "..\types\symbol.h"
 
@@ -48,10 +49,358 @@ namespace Olly {
 	//
 	/********************************************************************************************/
 
+	struct _decode_frame_ {
+		/*
+			A value being decoded, whose elements are still to be read.
+		*/
+
+		TYPE_KIND                 kind;
+		size_type                count;    // The elements to be read.
+		str_type                  name;    // The name of a set.
+		std::vector<let>         items;    // The elements read, and the arguments and body of a lambda.
+		std::vector<size_type>     ids;    // The symbol of each variable of a lambda.
+	};
+
+	struct _copy_frame_ {
+		/*
+			A value being copied, whose elements are still to be copied.
+		*/
+
+		_decode_frame_           frame;    // The elements copied.
+		std::vector<let>        source;    // The elements to be copied.
+	};
+
+	let build_frame(_decode_frame_& frame);                             // The value of a frame, once its elements are read.
+	let      decode(decoder& in);                                       // Read a value written by 'let::encode'.
+	let  copy_value(const let& value, const let_allocator* from);       // Copy the objects of a value made by an allocator.
+
 	/********************************************************************************************/
 	//
 	//                                 Function Implimentations
 	//
 	/********************************************************************************************/
 
+	let build_frame(_decode_frame_& frame) {
+
+		switch (frame.kind) {
+
+		case TYPE_KIND::STATEMENT_TYPE:
+			return statement(frame.items);
+
+		case TYPE_KIND::LIST_TYPE:
+			return list(frame.items);
+
+		case TYPE_KIND::SET_TYPE: {
+
+			_hash_map_builder_ entries;
+
+			for (size_type i = 0; i + 1 < frame.items.size(); i += 2) {
+				entries.set(frame.items[i], frame.items[i + 1]);
+			}
+
+			set s(entries.persistent());
+
+			s.bind_name(frame.name);
+
+			return s;
+		}
+
+		case TYPE_KIND::LAMBDA_TYPE: {
+
+			frame.items.resize(std::max<size_type>(frame.items.size(), 2));
+
+			if (frame.items.size() == 2) {
+				return lambda(frame.items[0], frame.items[1]);
+			}
+
+			scope vars;
+
+			for (size_type i = 2, stop = frame.items.size(); i < stop; i += 1) {
+				vars.set(frame.ids[i - 2], frame.items[i]);
+			}
+
+			return lambda(frame.items[0], frame.items[1], std::make_shared<const scope>(std::move(vars)));
+		}
+
+		default:
+			return expression(frame.items);
+		}
+	}
+
+	let decode(decoder& in) {
+		/*
+			Rebuild a value from its binary form.  A kind which is
+			not recognized, or a read past the end of the input, 
+			leaves the decoder no longer good and returns nothing.
+
+			The values which hold others are kept upon a stack of
+			frames while their elements are read, so a value of any
+			depth is read without recursion.
+		*/
+
+		std::vector<_decode_frame_> frames;
+
+		for (;;) {
+
+			if (!frames.empty() && frames.back().kind == TYPE_KIND::LAMBDA_TYPE && frames.back().items.size() >= 2) {
+				frames.back().ids.emplace_back(intern_symbol(in.read_text()));
+			}
+
+			TYPE_KIND kind = in.read_kind();
+
+			let value;
+
+			switch (kind) {
+
+			case TYPE_KIND::NOTHING_TYPE:
+				value = nothing();
+				break;
+
+			case TYPE_KIND::NUMBER_TYPE: {
+
+				real_type real = in.read_real();
+				real_type imgn = in.read_real();
+
+				value = number(real, imgn);
+			}	break;
+
+			case TYPE_KIND::BOOLEAN_TYPE: {
+
+				real_type term   = in.read_real();
+				real_type weight = in.read_real();
+
+				value = boolean(term, weight);
+			}	break;
+
+			case TYPE_KIND::STRING_TYPE:
+				value = string(in.read_text());
+				break;
+
+			case TYPE_KIND::SYMBOL_TYPE:
+				value = symbol(in.read_text());
+				break;
+
+			case TYPE_KIND::ERROR_TYPE:
+				value = error(in.read_text());
+				break;
+
+			case TYPE_KIND::OP_CALL_TYPE: {
+
+				size_type code = in.read_size();
+
+				if (code > static_cast<size_type>(OP_CODE::END_OPERATORS_OP)) {
+					in.fail();
+					break;
+				}
+
+				value = op_call_value(static_cast<OP_CODE>(code));
+			}	break;
+
+			case TYPE_KIND::EXPRESSION_TYPE:
+			case TYPE_KIND::STATEMENT_TYPE:
+			case TYPE_KIND::LIST_TYPE:
+			case TYPE_KIND::SET_TYPE:
+			case TYPE_KIND::LAMBDA_TYPE: {
+
+				_decode_frame_ frame;
+
+				frame.kind  = kind;
+				frame.count = 2;
+
+				if (kind == TYPE_KIND::SET_TYPE) {
+					frame.name  = in.read_text();
+					frame.count = in.read_size() * 2;
+				}
+				else if (kind != TYPE_KIND::LAMBDA_TYPE) {
+					frame.count = in.read_size();
+				}
+
+				if (frame.count && in.is()) {
+
+					frames.emplace_back(std::move(frame));
+
+					continue;
+				}
+
+				value = build_frame(frame);
+			}	break;
+
+			default:
+				in.fail();
+				break;
+			}
+
+			/*
+				Pass the value to the frame awaiting it, and build each
+				frame which is then complete, or which can not be read.
+			*/
+
+			for (;;) {
+
+				if (frames.empty()) {
+					return value;
+				}
+
+				_decode_frame_& frame = frames.back();
+
+				frame.items.emplace_back(std::move(value));
+
+				if (frame.kind == TYPE_KIND::LAMBDA_TYPE && frame.items.size() == 2) {
+					frame.count += in.read_size();
+				}
+
+				if (frame.items.size() < frame.count && in.is()) {
+					break;
+				}
+
+				value = build_frame(frame);
+
+				frames.pop_back();
+			}
+		}
+	}
+
+	let copy_value(const let& value, const let_allocator* from) {
+		/*
+			Copy each object of a value which was made by the allocator
+			given, and share every other object as it is.  An object
+			made elsewhere was made before those of the allocator, so
+			holds none of them, and neither do its elements.
+
+			Strings and errors are copied from their text.  The values
+			which hold others are rebuilt as when decoded, each kept
+			upon a stack of frames while its elements are copied, so a
+			value of any depth is copied without recursion.  An object
+			of the allocator which can not be copied becomes an error.
+		*/
+
+		std::vector<_copy_frame_> frames;
+
+		let next = value;
+
+		for (;;) {
+
+			let copy;
+
+			if (!from || next.allocator() != from) {
+				copy = std::move(next);
+			}
+			else {
+
+				_copy_frame_ frame;
+
+				frame.frame.kind  = next.kind();
+				frame.frame.count = 0;
+
+				bool_type composite = true;
+
+				switch (frame.frame.kind) {
+
+				case TYPE_KIND::STRING_TYPE:
+					copy      = string(next.cast<string>()->_value);
+					composite = false;
+					break;
+
+				case TYPE_KIND::ERROR_TYPE:
+					copy      = error(next.cast<error>()->_value);
+					composite = false;
+					break;
+
+				case TYPE_KIND::EXPRESSION_TYPE:
+					next.cast<expression>()->_expr.items(frame.source);
+					break;
+
+				case TYPE_KIND::STATEMENT_TYPE:
+					next.cast<statement>()->_expr.items(frame.source);
+					break;
+
+				case TYPE_KIND::LIST_TYPE:
+					next.cast<list>()->_list.items(frame.source);
+					break;
+
+				case TYPE_KIND::SET_TYPE: {
+
+					const set* s = next.cast<set>();
+
+					std::vector<let> keys;
+					std::vector<let> values;
+
+					s->_map.items(keys, values);
+
+					frame.frame.name = s->_name;
+
+					for (size_type i = 0, stop = keys.size(); i < stop; i += 1) {
+						frame.source.emplace_back(std::move(keys[i]));
+						frame.source.emplace_back(std::move(values[i]));
+					}
+				}	break;
+
+				case TYPE_KIND::LAMBDA_TYPE: {
+
+					const lambda* l = next.cast<lambda>();
+
+					frame.source.emplace_back(l->_args);
+					frame.source.emplace_back(l->_body);
+
+					if (l->_enclosure) {
+
+						scope vars = l->_enclosure->capture(scope::npos);
+
+						for (size_type i = 0, stop = vars.size(); i < stop; i += 1) {
+							frame.frame.ids.emplace_back(vars.id(i));
+							frame.source.emplace_back(vars.get(i));
+						}
+					}
+				}	break;
+
+				default:
+					copy      = error("copy_error");
+					composite = false;
+					break;
+				}
+
+				if (composite) {
+
+					if (!frame.source.empty()) {
+
+						next = frame.source.front();
+
+						frames.emplace_back(std::move(frame));
+
+						continue;
+					}
+
+					copy = build_frame(frame.frame);
+				}
+			}
+
+			/*
+				Pass the copy to the frame awaiting it, and build each
+				frame which is then complete.
+			*/
+
+			for (;;) {
+
+				if (frames.empty()) {
+					return copy;
+				}
+
+				_copy_frame_& top = frames.back();
+
+				top.frame.items.emplace_back(std::move(copy));
+
+				if (top.frame.items.size() < top.source.size()) {
+
+					next = top.source[top.frame.items.size()];
+
+					break;
+				}
+
+				copy = build_frame(top.frame);
+
+				frames.pop_back();
+			}
+		}
+	}
+
 } // end
\ No newline at end of file
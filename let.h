@@ -23,10 +23,20 @@
 /********************************************************************************************/
 
 #include <algorithm>
+#include <atomic>
 #include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <sstream>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -103,6 +113,10 @@ namespace Olly {
 	//          If the type cast is made to an incorrect data type then a std::nothing_ptr 
 	//          is returned instead.
 	//
+	//          A 'let' may be moved rather than copied, which hands an object held on
+	//          the heap over without touching its reference count.  The 'let' moved
+	//          from remains valid, holding nothing, or its own copy of an inline value.
+	//
 	//          The fundamental structure of the 'let' data type was inspired and extended 
 	//          from a presentation entitled:
 	//                 Title: Value Semantics and Concept-based Polymorphism
@@ -112,25 +126,489 @@ namespace Olly {
 	/********************************************************************************************/
 	const enum class OP_CODE;
 
+	class let;
+
+	/********************************************************************************************/
+	//
+	//                                 'TYPE_KIND' Enum Definition
+	//
+	//          A compact identifier of the built in data types.  It allows the interpreter
+	//          to dispatch on the kind of an object without building its type name string.
+	//          User defined types default to OBJECT_TYPE.  
+	//
+	/********************************************************************************************/
+
+	enum class TYPE_KIND {
+		OBJECT_TYPE = 0,
+
+		NOTHING_TYPE, NUMBER_TYPE, BOOLEAN_TYPE, STRING_TYPE, SYMBOL_TYPE, OP_CALL_TYPE,
+		EXPRESSION_TYPE, STATEMENT_TYPE, LAMBDA_TYPE, LIST_TYPE, SET_TYPE, ERROR_TYPE
+	};
+
+	/********************************************************************************************/
+	//
+	//                                'inline_storage' Trait Definition
+	//
+	//          Small value types may specialize this trait to be held directly within
+	//          a 'let' rather than on the heap.  This avoids an allocation and the 
+	//          reference counting of a heap object for scalars like numbers.
+	//          The type must still fit within 'let::INLINE_SIZE' to be stored inline,
+	//          and must not own any resources, as its destructor is never run.  So it
+	//          needs no virtual destructor, which would only enlarge every 'let'.
+	//
+	/********************************************************************************************/
+
+	template <typename T>
+	struct inline_storage {
+		static const bool_type value = false;
+	};
+
+	/********************************************************************************************/
+	//
+	//                              'let_allocator' Class Definition
+	//
+	//          A let_allocator supplies the memory of the objects a 'let' holds on the
+	//          heap.  An allocator is installed upon a thread by an allocator_scope, and
+	//          each 'let' constructed upon that thread within the scope takes its memory
+	//          from the allocator.  Without an allocator installed, objects are taken
+	//          from the object_pool of the thread.
+	//
+	//          The memory of an object is always returned to the allocator it came from,
+	//          so an allocator must remain until each object it supplied is released.
+	//          The objects of an allocator are counted without atomic operations, so
+	//          they must not be copied or released upon another thread, nor held by any
+	//          object which may be.  So an owner of an allocator copies each value which
+	//          leaves its scope out to the object_pool, as the evaluator does with the
+	//          result of 'eval'.
+	//
+	/********************************************************************************************/
+
+	struct allocation_stats {
+		size_type   allocations;    // The objects allocated.
+		size_type deallocations;    // The objects returned.
+		size_type         bytes;    // The bytes allocated in total.
+		size_type    live_bytes;    // The bytes currently allocated.
+		size_type    peak_bytes;    // The most bytes allocated at once.
+		size_type        blocks;    // The blocks taken from the heap to allocate within.
+		size_type          heap;    // The objects too large to pool, taken from the heap.
+	};
+
+	class let_allocator {
+
+	public:
+
+		virtual ~let_allocator();
+
+		virtual void*     allocate(size_type bytes)                   = 0;
+		virtual void    deallocate(void* p, size_type bytes)          = 0;
+
+		static let_allocator* current();                                     // The allocator installed upon this thread, if any.
+
+	private:
+
+		static let_allocator*& installed();
+
+		friend class allocator_scope;
+	};
+
+	class allocator_scope {
+
+		let_allocator* _previous;
+
+	public:
+
+		allocator_scope(let_allocator* allocator);                           // Install the allocator until the scope ends.
+		~allocator_scope();
+
+	private:
+		allocator_scope();
+		allocator_scope(const allocator_scope& obj) = delete;
+	};
+
+	template <typename U>
+	class hook_allocator {
+		/*
+			Adapts a let_allocator to the allocator interface, for use
+			with 'std::allocate_shared'.
+		*/
+
+	public:
+
+		typedef U value_type;
+
+		let_allocator* _allocator;
+
+		hook_allocator(let_allocator* allocator) noexcept;
+		template <typename V> hook_allocator(const hook_allocator<V>& other) noexcept;
+
+		U*          allocate(std::size_t n);
+		void      deallocate(U* p, std::size_t n) noexcept;
+
+		template <typename V> bool_type operator==(const hook_allocator<V>& other) const noexcept;
+		template <typename V> bool_type operator!=(const hook_allocator<V>& other) const noexcept;
+	};
+
+	/********************************************************************************************/
+	//
+	//                              'object_pool' Class Definition
+	//
+	//          The object_pool supplies the objects of a 'let' when no let_allocator is
+	//          installed.  Each thread keeps a free list for each size of object, so
+	//          the control block and data of a value are usually taken from the list
+	//          and returned to it, without a call into the system allocator.  The free
+	//          lists are filled from blocks which are kept for the life of the program,
+	//          so an object may safely be released upon a thread other than the one
+	//          which allocated it.  It then joins the free list of the releasing thread.
+	//
+	//          A thread holds at most a block's worth of objects upon each list.  The
+	//          excess, and all it holds when it ends, is handed to a depot shared by
+	//          every thread, and a thread refills an empty list from the depot before
+	//          cutting new objects from a block.  So memory released upon one thread
+	//          is reused by another, and the pool does not grow when threads come and
+	//          go, or when one thread releases what another allocates.
+	//
+	//          The counters are kept for the whole program.  Each thread adds its own
+	//          counts to them whenever it goes to the depot, and when it asks for them.
+	//
+	/********************************************************************************************/
+
+	class object_pool {
+
+		static const size_type BLOCK_SIZE = 1 << 16;
+		static const size_type GRAIN      = alignof(std::max_align_t);
+		static const size_type CLASSES    = 32;                           // Objects up to GRAIN * CLASSES bytes are pooled.
+
+		struct _free_ {
+			_free_* _next;
+		};
+
+		struct _counts_ {
+			size_type         allocations;
+			size_type       deallocations;
+			size_type               bytes;
+			size_type               freed;    // The bytes returned.
+			size_type              blocks;
+			size_type                heap;
+			std::ptrdiff_t           rise;    // The most the bytes less the freed have reached since the last flush.
+		};
+
+		struct _lists_ {
+			_free_*           _free[CLASSES];
+			size_type         _held[CLASSES];    // The objects upon each list.
+			char*                       _next;    // The unused remainder of the newest block.
+			char*                        _end;
+			_counts_                   _counts;    // Counts not yet added to the depot.
+			bool_type                  _active;    // The thread will return its lists when it ends.
+			bool_type                 _retired;    // The thread has ended, so the depot is used directly.
+		};
+
+		struct _depot_ {
+			std::mutex                                   _lock;
+			_free_*                             _free[CLASSES];
+			std::atomic<size_type>              _held[CLASSES];    // Read without the lock, to pass over an empty list.
+			std::vector<std::pair<char*, char*>>         _spans;    // The unused remainders of the blocks of ended threads.
+			std::vector<char*>                          _blocks;    // Every block, so the memory remains reachable.
+
+			std::atomic<size_type>                 allocations;
+			std::atomic<size_type>               deallocations;
+			std::atomic<size_type>                       bytes;
+			std::atomic<size_type>                       freed;
+			std::atomic<size_type>                  peak_bytes;
+			std::atomic<size_type>                      blocks;
+			std::atomic<size_type>                        heap;
+		};
+
+		struct _retire_ {
+			~_retire_();                                                     // Return the lists of the thread to the depot.
+		};
+
+	public:
+
+		static void*        allocate(size_type bytes);
+		static void       deallocate(void* p, size_type bytes) noexcept;
+
+		static allocation_stats stats();                                     // The counters of the whole program.
+
+	private:
+
+		static _lists_&         lists();
+		static _depot_&         depot();                                     // Never destroyed, so usable as the program ends.
+
+		static void              join(_lists_& l);
+		static void             flush(_lists_& l) noexcept;
+		static void            refill(_lists_& l, size_type n);
+		static void             spill(_lists_& l, size_type n) noexcept;
+		static void        take_block(_lists_& l);                           // A span to cut objects from, else a new block.
+
+		static size_type    size_class(size_type bytes);
+	};
+
+	template <typename U>
+	class pool_allocator {
+		/*
+			Adapts the object_pool to the allocator interface, for use
+			with 'std::allocate_shared'.
+		*/
+
+	public:
+
+		typedef U value_type;
+
+		pool_allocator() noexcept;
+		template <typename V> pool_allocator(const pool_allocator<V>& other) noexcept;
+
+		U*          allocate(std::size_t n);
+		void      deallocate(U* p, std::size_t n) noexcept;
+
+		template <typename V> bool_type operator==(const pool_allocator<V>& other) const noexcept;
+		template <typename V> bool_type operator!=(const pool_allocator<V>& other) const noexcept;
+	};
+
+	template <typename T, typename... A>
+	std::shared_ptr<T> make_pooled(A&&... args);                             // Make a shared object with the installed allocator, else the pool.
+
+	/********************************************************************************************/
+	//
+	//                                 '_nesting_' Class Definition
+	//
+	//          The _nesting_ class writes values into a buffer one within another, as
+	//          the output_sink and encoder do, but only to a fixed depth.  A value nested
+	//          more deeply is set aside with its place within the buffer, and written
+	//          in a later pass.  The passes are then joined in order by following a
+	//          stack of them, so a value of any depth is written without deep recursion.
+	//
+	/********************************************************************************************/
+
+	class _nesting_ {
+
+		static const size_type DEPTH_LIMIT = 256;    // The values written one within another in a pass.
+
+		struct _segment_ {
+			str_type                    _text;
+			std::vector<size_type>   _offsets;    // The place of each value set aside.
+			std::vector<let>          _values;
+			std::vector<char>          _modes;
+			size_type                   _next;    // The next value set aside to be written.
+			size_type                    _pos;    // The text joined so far.
+		};
+
+		size_type                      _depth;    // The values being written, one within another.
+		size_type                       _base;    // The start of the outermost value within the buffer.
+		bool_type                    _joining;
+		std::vector<size_type>       _offsets;    // The place within the buffer of each value set aside.
+		std::vector<let>              _values;    // The values nested too deeply to write in place.
+		std::vector<char>              _modes;    // The way each value set aside is to be written.
+
+	public:
+
+		_nesting_();
+
+		template <typename F>
+		void           write(str_type& buffer, const let& value, char mode, F write_here);  // Write the value, as 'write_here(value, mode)' would.
+
+		bool_type    holding()                                       const;  // Is the buffer incomplete, with values set aside or being joined.
+		void         flushed();                                              // The buffer was emptied, while holding nothing.
+		void           clear();
+	};
+
+	/********************************************************************************************/
+	//
+	//                        'output_sink' and 'file_sink' Class Definitions
+	//
+	//          An output sink collects the text of values as they are printed.  Each
+	//          value appends its text directly to the one sink, so printing a nested
+	//          structure is a single pass over it, without a stream built for each
+	//          element.  The output_sink keeps its text within a buffer, while the
+	//          file_sink passes the buffer on to a file whenever it grows past a
+	//          limit, and once more when the sink is flushed or destroyed.
+	//
+	/********************************************************************************************/
+
+	class output_sink {
+
+	protected:
+
+		str_type      _buffer;
+		size_type      _limit;    // Flush the buffer once it holds this many characters.
+		bool_type  _show_sign;
+		_nesting_    _nesting;
+
+	public:
+
+		output_sink();
+		virtual ~output_sink();
+
+		void            write_str(const let& value);
+		void           write_repr(const let& value);
+
+		output_sink& operator << (const str_type& text);
+		output_sink& operator << (std::string_view text);
+		output_sink& operator << (const char* text);
+		output_sink& operator << (char c);
+		output_sink& operator << (bool_type b);
+		output_sink& operator << (int_type n);
+		output_sink& operator << (size_type n);
+		output_sink& operator << (real_type n);
+		output_sink& operator << (double n);
+		output_sink& operator << (const void* p);
+
+		void           show_sign(bool_type show);                            // Print a '+' before positive numbers.
+
+		const str_type&     text()                                           const;
+		void               clear();
+
+		virtual void       flush();
+
+	protected:
+
+		void              append(const char* text, size_type n);
+	};
+
+	class file_sink : public output_sink {
+
+		std::FILE* _file;
+
+	public:
+
+		file_sink(std::FILE* file);
+		virtual ~file_sink();
+
+		void flush();
+
+	private:
+		file_sink();
+		file_sink(const file_sink& obj) = delete;
+	};
+
+	/********************************************************************************************/
+	//
+	//                                'hash_cache' Class Definition
+	//
+	//          A hash_cache holds the hash of an immutable value once it has been
+	//          computed, so that it is only computed once.  A copy of the cache starts
+	//          out empty, as a copy is usually made to be modified into a new value.
+	//
+	//          The value may be shared between threads, so the hash is held atomically.
+	//          Each thread computes the same hash, so relaxed ordering is sufficient.
+	//
+	/********************************************************************************************/
+
+	class hash_cache {
+
+		mutable std::atomic<size_type> _value;    // Zero until the hash is known.
+
+	public:
+
+		hash_cache();
+		hash_cache(const hash_cache& obj);
+
+		hash_cache& operator = (const hash_cache& obj);
+
+		bool_type          is()                                              const;
+		size_type         get()                                              const;
+		size_type         set(size_type hash)                                const;  // Keep the hash, returning it.
+	};
+
+	size_type hash_combine(size_type seed, size_type value);     // Mix a value into a running hash.
+	size_type    hash_real(real_type n);                         // Hash a real, with zero and negative zero alike.
+
+	/********************************************************************************************/
+	//
+	//                          'encoder' and 'decoder' Class Definitions
+	//
+	//          The encoder appends a compact binary form of values to a buffer of bytes,
+	//          and the decoder reads them back.  Sizes are written as variable length
+	//          integers and reals as their raw bytes, so an encoding can only be read
+	//          by a build sharing the same representation of 'real_type'.  Once the
+	//          decoder has run past the end of its buffer it is no longer good, and
+	//          it returns zero values.  Likewise the encoder is no longer good once
+	//          it is given a value with no binary form.  Both write and read a value
+	//          of any depth without deep recursion.
+	//
+	/********************************************************************************************/
+
+	class encoder {
+
+		str_type      _bytes;
+		_nesting_   _nesting;
+		bool_type      _good;
+
+	public:
+
+		encoder();
+
+		bool_type       is()                                                 const;  // Has every value written a binary form.
+		void          fail();                                                        // Mark the output as incomplete.
+
+		void        write_value(const let& value);                                   // Write the binary form of a value.
+		void         write_byte(unsigned char c);
+		void         write_kind(TYPE_KIND kind);
+		void         write_size(size_type n);
+		void         write_real(real_type n);
+		void         write_text(const str_type& text);
+
+		const str_type&   bytes()                                            const;
+		void              clear();
+	};
+
+	class decoder {
+
+		const char*   _pos;
+		const char*   _end;
+		bool_type    _good;
+
+	public:
+
+		decoder(const char* begin, const char* end);
+		decoder(const str_type& bytes);
+
+		bool_type       is()                                                 const;  // Has every read been within the buffer.
+		bool_type   at_end()                                                 const;
+		void          fail();                                                        // Mark the input as malformed.
+
+		unsigned char    read_byte();
+		TYPE_KIND        read_kind();
+		size_type        read_size();
+		real_type        read_real();
+		str_type         read_text();
+	};
+
 	class let {
 		struct interface_type;
 
+		friend class encoder;                                                  // Each writes a value through its interface.
+		friend class output_sink;
+
 	public:
 
+		static const size_type INLINE_SIZE  = 48;                              // The largest inline data_type, a number or boolean.
+		static const size_type INLINE_ALIGN = alignof(std::max_align_t);
+
 		let();
+		let(const let& obj);
+		let(let&& obj) noexcept;
 		template <typename T>          let(T  x);
 		template <typename T>          let(T* x);
+		~let();
+
+		let& operator=(const let& obj);
+		let& operator=(let&& obj) noexcept;
 
 		template <typename T> const T* cast()                              const;  // Cast the object as an instance of the specified type.
+		template <typename T> static constexpr bool_type is_inline();              // Is the type held within the let.
+
+		const let_allocator* allocator()                                   const;  // The allocator of an object held on the heap, else null.
 
 		str_type             id()                                          const;  // Return the typeid of the object.
 		bool_type       is_type(const let& other)                          const;  // Compair two objects by typeid.  
 		size_type          hash()                                          const;  // Get the hash of an object.
 
 		str_type           type()                                          const;  // The class generated type name.
+		TYPE_KIND          kind()                                          const;  // The built in kind of the object.
 		bool_type            is()                                          const;  // Is or is not the object defined.
-		void                str(stream_type& out)                          const;  // String representation of the object.
-		void               repr(stream_type& out)                          const;
+		void                str(output_sink& out)                          const;  // String representation of the object.
+		void               repr(output_sink& out)                          const;
+		void             encode(encoder& out)                              const;  // Append the binary form of the object.
 
 		real_type          comp(const let& other)                          const;  // Compare two objects. 0 = equality, > 0 = grater than, < 0 = less than.
 		bool_type            eq(const let& other)                          const;  // Equal to.
@@ -206,6 +684,7 @@ namespace Olly {
 			//
 			/********************************************************************************************/
 
+			interface_type(const void* tag);
 			virtual  ~interface_type() = default;
 			virtual operator bool()                                                 const = 0;
 
@@ -214,9 +693,11 @@ namespace Olly {
 			virtual std::size_t      _hash()                                        const = 0;
 
 			virtual str_type         _type()                                        const = 0;
+			virtual TYPE_KIND        _kind()                                        const = 0;
 			virtual bool_type        _is()                                          const = 0;
-			virtual void             _str(stream_type& out)                         const = 0;
-			virtual void             _repr(stream_type& out)                        const = 0;
+			virtual void             _str(output_sink& out)                         const = 0;
+			virtual void             _repr(output_sink& out)                        const = 0;
+			virtual void             _encode(encoder& out)                          const = 0;
 
 			virtual real_type        _comp(const let& other)                        const = 0;
 
@@ -253,6 +734,10 @@ namespace Olly {
 			virtual str_type        _help()                                         const = 0;
 
 			virtual OP_CODE         _op_code()                                      const = 0;
+
+			virtual interface_type* _copy(void* buffer)                             const = 0;
+
+			const void* const       _tag;                                                   // Identifies the held data_type.
 		};
 
 		template <typename T>
@@ -275,9 +760,11 @@ namespace Olly {
 			std::size_t     _hash()                                         const;
 
 			str_type        _type()                                         const;
+			TYPE_KIND       _kind()                                         const;
 			bool_type       _is()                                           const;
-			void            _str(stream_type& out)                          const;
-			void            _repr(stream_type& out)                         const;
+			void            _str(output_sink& out)                          const;
+			void            _repr(output_sink& out)                         const;
+			void            _encode(encoder& out)                           const;
 
 			real_type       _comp(const let& other)                         const;
 
@@ -315,10 +802,66 @@ namespace Olly {
 
 			OP_CODE         _op_code()                                      const;
 
+			interface_type* _copy(void* buffer)                             const;
+
 			T               _data;
 		};
 
-		std::shared_ptr<const interface_type> _self;
+		struct header_type {
+
+			/******************************************************************************************/
+			//
+			//                                'header_type' Class Definition
+			//
+			//             The reference count of an object held on the heap, placed just
+			//             ahead of the object within the same allocation.  An object taken
+			//             from a let_allocator never leaves the thread of the allocator's
+			//             owner, so its count is kept without atomic operations.  An object
+			//             taken from the object_pool may be released upon any thread, so
+			//             its count is atomic.  Defining OLLY_SINGLE_THREADED keeps every
+			//             count without atomic operations.
+			//
+			/******************************************************************************************/
+
+			std::atomic<std::uint32_t>    _refs;
+			std::uint32_t                _bytes;    // The size of the whole allocation.
+			let_allocator*           _allocator;    // The allocator of the object, else the pool.
+		};
+
+		static const size_type HEADER_SIZE   = (sizeof(header_type) + INLINE_ALIGN - 1) / INLINE_ALIGN * INLINE_ALIGN;
+		static const size_type RELEASE_DEPTH = 256;    // The objects destroyed one within another, before the rest are queued.
+
+		struct release_type {
+			const interface_type*     _obj;
+			release_type*            _next;
+		};
+
+		struct releases_type {
+			size_type                _depth;    // The objects being destroyed, one within another.
+			release_type*          _pending;    // The objects queued to be destroyed.
+		};
+
+		typedef std::aligned_storage<INLINE_SIZE, INLINE_ALIGN>::type     buffer_type;
+
+		template <typename T, typename... A>
+		static const interface_type* allocate_data(A&&... args);                         // Place a data_type with the installed allocator, else the pool.
+
+		static header_type*   header(const interface_type* obj);
+		static void           retain(const interface_type* obj);
+		static void            unref(const interface_type* obj);
+		static void          destroy(const interface_type* obj);
+		static void          dispose(const interface_type* obj);
+		static releases_type& releases();
+
+		template <typename T> static const void* type_tag();                             // A unique address identifying each data_type.
+
+		bool_type stored_inline()                                           const;
+		void            acquire(const let& obj);
+		void            acquire(let&& obj) noexcept;
+		void            release();
+
+		const interface_type* _self;                                                     // The held object, inline or on the heap.
+		buffer_type         _buffer;
 	};
 
 	/********************************************************************************************/
@@ -344,15 +887,22 @@ namespace Olly {
 		virtual ~nothing();
 
 		friend str_type      _type_(const nothing& self);
+		friend TYPE_KIND     _kind_(const nothing& self);
 		friend bool_type       _is_(const nothing& self);
 		friend real_type     _comp_(const nothing& self, const let& other);
+		friend std::size_t   _hash_(const nothing& self);
 
-		friend void           _str_(stream_type& out, const nothing& self);
-		friend void          _repr_(stream_type& out, const nothing& self);
+		friend void           _str_(output_sink& out, const nothing& self);
+		friend void          _repr_(output_sink& out, const nothing& self);
 
 		friend bool_type  _is_nothing_(const nothing& self);
 	};
 
+	template <>
+	struct inline_storage<nothing> {
+		static const bool_type value = true;
+	};
+
 	/********************************************************************************************/
 	//
 	//                                Basic Primitive Declarations
@@ -367,6 +917,7 @@ namespace Olly {
 
 	str_type  str(const  let& a);                    // Convert any 'let' to a str_type.
 	str_type repr(const let& a);                     // Convert any 'let' to a str_type representation of the 'let'.
+	void      str(output_sink& out, const let& a);   // Append the string of any 'let' to a sink.
 
 	inline bool_type expression_is_empty(let expr);  // Determine if an expression is empty.
 	inline bool_type object_is_empty(let expr);      // Determine if an object is empty.
@@ -426,6 +977,15 @@ namespace Olly {
 	}
 
 
+	template<typename T>            /****  Type Kind  ****/
+	TYPE_KIND _kind_(const T& self);
+
+	template<typename T>
+	TYPE_KIND _kind_(const T& self) {
+		return TYPE_KIND::OBJECT_TYPE;
+	}
+
+
 	template<typename T>            /****  Boolean Conversion  ****/
 	bool_type _is_(const T& self);
 
@@ -436,20 +996,29 @@ namespace Olly {
 
 
 	template<typename T>            /****  String Conversion  ****/
-	void _str_(stream_type& out, const T& self);
+	void _str_(output_sink& out, const T& self);
 
 	template<typename T>
-	void _str_(stream_type& out, const T& self) {
-		out << "object<" << &self << "," << _type_(self) << ">";
+	void _str_(output_sink& out, const T& self) {
+		out << "object<" << static_cast<const void*>(&self) << "," << _type_(self) << ">";
 	}
 
 
 	template<typename T>            /****  String Representation  ****/
-	void _repr_(stream_type& out, const T& self);
+	void _repr_(output_sink& out, const T& self);
+
+	template<typename T>
+	void _repr_(output_sink& out, const T& self) {
+		out << "nothing";
+	}
+
+
+	template<typename T>            /****  Binary Encoding  ****/
+	void _encode_(encoder& out, const T& self);
 
 	template<typename T>
-	void _repr_(stream_type& out, const T& self) {
-		out << str(nothing());
+	void _encode_(encoder& out, const T& self) {
+		out.fail();
 	}
 
 
@@ -723,6 +1292,10 @@ namespace Olly {
 		return "nothing";
 	}
 
+	TYPE_KIND _kind_(const nothing& self) {
+		return TYPE_KIND::NOTHING_TYPE;
+	}
+
 	bool_type _is_(const nothing& self) {
 		return false;
 	}
@@ -731,11 +1304,15 @@ namespace Olly {
 		return other.is_nothing() ? 0.0 : NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const nothing& self) {
+	std::size_t _hash_(const nothing& self) {
+		return static_cast<std::size_t>(TYPE_KIND::NOTHING_TYPE);
+	}
+
+	void _str_(output_sink& out, const nothing& self) {
 		out << "nothing";
 	}
 
-	void _repr_(stream_type& out, const nothing& self) {
+	void _repr_(output_sink& out, const nothing& self) {
 		_str_(out, self);
 	}
 
@@ -751,59 +1328,334 @@ namespace Olly {
 	//
 	/********************************************************************************************/
 
-	let::let() : _self(std::make_shared<data_type<Olly::nothing>>(Olly::nothing())) {
+	let::let() : _self(new (&_buffer) data_type<Olly::nothing>(Olly::nothing())) {
+	}
+
+	forceinline let::let(const let& obj) : _self(nullptr) {
+		acquire(obj);
+	}
+
+	forceinline let::let(let&& obj) noexcept : _self(nullptr) {
+		acquire(std::move(obj));
 	}
 
 	template <typename T>
-	let::let(T x) : _self(std::make_shared<data_type<T>>(std::move(x))) {
+	let::let(T x) : _self(nullptr) {
+
+		if constexpr (is_inline<T>()) {
+			_self = new (&_buffer) data_type<T>(std::move(x));
+		}
+		else {
+			_self = allocate_data<T>(std::move(x));
+		}
 	}
 
 	template <typename T>
-	let::let(T* x) : _self(std::make_shared<data_type<T>>(x)) {
+	let::let(T* x) : _self(allocate_data<T>(x)) {
 	}
 
-	template <typename T> const T* let::cast() const {
+	template <typename T, typename... A>
+	const let::interface_type* let::allocate_data(A&&... args) {
+		/*
+			Allocate the header and the object together, with the
+			header counting the single reference being made.
+		*/
 
-		let n = T();
+		static_assert(alignof(data_type<T>) <= INLINE_ALIGN, "The type is aligned beyond what a let_allocator provides.");
 
-		if (is_type(n)) {
+		let_allocator* allocator = let_allocator::current();
+		size_type      bytes     = HEADER_SIZE + sizeof(data_type<T>);
 
-			const T* p = static_cast<T*>(const_cast<interface_type*>(_self.get())->_vptr());
+		char* p = static_cast<char*>(allocator ? allocator->allocate(bytes) : object_pool::allocate(bytes));
 
-			if (p) {
-				return p;
-			}
+		try {
+			const interface_type* obj = new (p + HEADER_SIZE) data_type<T>(std::forward<A>(args)...);
+
+			new (p) header_type{ { 1 }, static_cast<std::uint32_t>(bytes), allocator };
+
+			return obj;
 		}
+		catch (...) {
 
-		return nullptr;
-	}
+			if (allocator) {
+				allocator->deallocate(p, bytes);
+			}
+			else {
+				object_pool::deallocate(p, bytes);
+			}
 
-	str_type let::id() const {
-		return _self->_id();
+			throw;
+		}
 	}
 
-	bool_type let::is_type(const let& other) const {
-		return _self->_id() == other._self->_id();
+	forceinline let::header_type* let::header(const interface_type* obj) {
+		return reinterpret_cast<header_type*>(const_cast<char*>(reinterpret_cast<const char*>(obj)) - HEADER_SIZE);
 	}
 
-	std::size_t let::hash() const {
-		return _self->_hash();
-	}
+	forceinline void let::retain(const interface_type* obj) {
 
-	str_type let::type() const {
+		header_type* h = header(obj);
+
+#ifndef OLLY_SINGLE_THREADED
+		if (!h->_allocator) {
+			h->_refs.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+#endif
+		h->_refs.store(h->_refs.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+	}
+
+	forceinline void let::unref(const interface_type* obj) {
+		/*
+			Destroy the object with its last reference, and
+			return the memory to where it came from.
+		*/
+
+		header_type* h = header(obj);
+
+		std::uint32_t refs;
+
+#ifndef OLLY_SINGLE_THREADED
+		if (!h->_allocator) {
+			refs = h->_refs.fetch_sub(1, std::memory_order_acq_rel) - 1;
+		}
+		else
+#endif
+		{
+			refs = h->_refs.load(std::memory_order_relaxed) - 1;
+			h->_refs.store(refs, std::memory_order_relaxed);
+		}
+
+		if (refs) {
+			return;
+		}
+
+		destroy(obj);
+	}
+
+	void let::destroy(const interface_type* obj) {
+		/*
+			An object may hold the last reference to others, which are
+			released within its own destructor.  Past a fixed depth they
+			are queued rather than destroyed, and the outermost call
+			destroys the queue, so a deeply nested value is destroyed
+			without deep recursion.  The queue is taken from the pool,
+			and holds no destructor, so it may be used as a thread ends.
+		*/
+
+		releases_type& r = releases();
+
+		if (r._depth >= RELEASE_DEPTH) {
+
+			void* p = object_pool::allocate(sizeof(release_type));
+
+			r._pending = new (p) release_type{ obj, r._pending };
+
+			return;
+		}
+
+		r._depth += 1;
+
+		dispose(obj);
+
+		if (r._depth == 1) {
+
+			while (r._pending) {
+
+				release_type* next = r._pending;
+
+				r._pending = next->_next;
+
+				const interface_type* queued = next->_obj;
+
+				object_pool::deallocate(next, sizeof(release_type));
+
+				dispose(queued);
+			}
+		}
+
+		r._depth -= 1;
+	}
+
+	void let::dispose(const interface_type* obj) {
+
+		header_type* h = header(obj);
+
+		let_allocator* allocator = h->_allocator;
+		size_type      bytes     = h->_bytes;
+
+		obj->~interface_type();
+		h->~header_type();
+
+		if (allocator) {
+			allocator->deallocate(h, bytes);
+		}
+		else {
+			object_pool::deallocate(h, bytes);
+		}
+	}
+
+	let::releases_type& let::releases() {
+
+		static thread_local releases_type r = {};
+
+		return r;
+	}
+
+	forceinline let::~let() {
+		release();
+	}
+
+	let& let::operator=(const let& obj) {
+		/*
+			Take a copy before releasing the current object, as
+			the current object may be the only owner of 'obj'.
+		*/
+
+		if (this != &obj) {
+
+			let temp(obj);
+
+			release();
+			acquire(std::move(temp));
+		}
+
+		return *this;
+	}
+
+	let& let::operator=(let&& obj) noexcept {
+
+		if (this != &obj) {
+
+			let temp(std::move(obj));
+
+			release();
+			acquire(std::move(temp));
+		}
+
+		return *this;
+	}
+
+	forceinline bool_type let::stored_inline() const {
+		return static_cast<const void*>(_self) == static_cast<const void*>(&_buffer);
+	}
+
+	const let_allocator* let::allocator() const {
+
+		if (stored_inline()) {
+			return nullptr;
+		}
+
+		return header(_self)->_allocator;
+	}
+
+	forceinline void let::acquire(const let& obj) {
+		/*
+			Copy an inline object into the buffer, else share
+			the reference to the object held on the heap.
+		*/
+
+		if (obj.stored_inline()) {
+			_self = obj._self->_copy(&_buffer);
+		}
+		else {
+			retain(obj._self);
+			_self = obj._self;
+		}
+	}
+
+	forceinline void let::acquire(let&& obj) noexcept {
+		/*
+			Take ownership of a heap object, leaving 'obj' holding
+			nothing.  Inline objects are simply copied.
+		*/
+
+		if (obj.stored_inline()) {
+			_self = obj._self->_copy(&_buffer);
+		}
+		else {
+			_self = obj._self;
+
+			obj._self = new (&obj._buffer) data_type<Olly::nothing>(Olly::nothing());
+		}
+	}
+
+	forceinline void let::release() {
+		/*
+			Inline objects hold no resources, so their storage
+			is simply reused without running a destructor.
+		*/
+
+		if (!stored_inline()) {
+			unref(_self);
+		}
+
+		_self = nullptr;
+	}
+
+	template <typename T> const T* let::cast() const {
+		/*
+			Compare the type tag of the held object against the
+			tag of the requested type.  A match guarantees the
+			held object is a data_type<T>.
+		*/
+
+		if (_self->_tag == type_tag<T>()) {
+			return &static_cast<const data_type<T>*>(_self)->_data;
+		}
+
+		return nullptr;
+	}
+
+	template <typename T> const void* let::type_tag() {
+		/*
+			Each instantiation owns a distinct static, so its
+			address serves as a unique identifier of the type.
+		*/
+
+		static const char tag = 0;
+
+		return &tag;
+	}
+
+	template <typename T> constexpr bool_type let::is_inline() {
+		return inline_storage<T>::value && sizeof(data_type<T>) <= INLINE_SIZE && alignof(data_type<T>) <= INLINE_ALIGN;
+	}
+
+	str_type let::id() const {
+		return _self->_id();
+	}
+
+	bool_type let::is_type(const let& other) const {
+		return _self->_tag == other._self->_tag;
+	}
+
+	std::size_t let::hash() const {
+		return _self->_hash();
+	}
+
+	str_type let::type() const {
 		return _self->_type();
 	}
 
+	TYPE_KIND let::kind() const {
+		return _self->_kind();
+	}
+
 	bool_type let::is() const {
-		return const_cast<interface_type*>(_self.get())->_is();
+		return _self->_is();
+	}
+
+	void let::str(output_sink& out) const {
+		out.write_str(*this);
 	}
 
-	void let::str(stream_type& out) const {
-		_self->_str(out);
+	void let::repr(output_sink& out) const {
+		out.write_repr(*this);
 	}
 
-	void let::repr(stream_type& out) const {
-		_self->_repr(out);
+	void let::encode(encoder& out) const {
+		out.write_value(*this);
 	}
 
 	real_type let::comp(const let& other) const {
@@ -1009,8 +1861,11 @@ namespace Olly {
 	//
 	/********************************************************************************************/
 
+	let::interface_type::interface_type(const void* tag) : _tag(tag) {
+	}
+
 	template <typename T>
-	let::data_type<T>::data_type(T val) : _data(std::move(val)) {
+	let::data_type<T>::data_type(T val) : interface_type(type_tag<T>()), _data(std::move(val)) {
 	}
 
 	template <typename T>
@@ -1038,21 +1893,31 @@ namespace Olly {
 		return _type_(_data);
 	}
 
+	template <typename T>
+	TYPE_KIND let::data_type<T>::_kind() const {
+		return _kind_(_data);
+	}
+
 	template <typename T>
 	bool_type let::data_type<T>::_is() const {
 		return _is_(_data);
 	}
 
 	template <typename T>
-	void let::data_type<T>::_str(stream_type& out) const {
+	void let::data_type<T>::_str(output_sink& out) const {
 		_str_(out, _data);
 	}
 
 	template <typename T>
-	void let::data_type<T>::_repr(stream_type& out) const {
+	void let::data_type<T>::_repr(output_sink& out) const {
 		_repr_(out, _data);
 	}
 
+	template <typename T>
+	void let::data_type<T>::_encode(encoder& out) const {
+		_encode_(out, _data);
+	}
+
 	template <typename T>
 	real_type let::data_type<T>::_comp(const let& other) const {
 		return _comp_(_data, other);
@@ -1193,6 +2058,21 @@ namespace Olly {
 		return _op_code_(_data);
 	}
 
+	template <typename T>
+	let::interface_type* let::data_type<T>::_copy(void* buffer) const {
+		/*
+			Only inline objects are ever copied, all
+			others are shared by reference.
+		*/
+
+		if constexpr (is_inline<T>()) {
+			return new (buffer) data_type<T>(_data);
+		}
+		else {
+			return nullptr;
+		}
+	}
+
 	/********************************************************************************************/
 	//
 	//                            Basic Primitive Implementations
@@ -1208,7 +2088,15 @@ namespace Olly {
 	}
 
 	void print(const let& a) {
-		print(str(a));
+
+		file_sink out(stdout);
+
+		str(out, a);
+
+		out << '\n';
+		out.flush();
+
+		std::fflush(stdout);
 	}
 
 	str_type str(const let& a) {
@@ -1216,24 +2104,11 @@ namespace Olly {
 			Convert a 'let' to its string representation.
 		*/
 
-		stream_type stream;
+		output_sink out;
 
-		stream << std::boolalpha;
-
-		if (a.type() == "format") {
-			/*
-				The 'format' data type must be printed using
-				its string representation, else it would only
-				impart its formating to the stream instead of
-				being printed to it.
-			*/
-			a.repr(stream);
-		}
-		else {
-			a.str(stream);
-		}
+		str(out, a);
 
-		return stream.str();
+		return out.text();
 	}
 
 	str_type repr(const let& a) {
@@ -1241,13 +2116,27 @@ namespace Olly {
 			Convert a 'let' to its representation as a string.
 		*/
 
-		stream_type stream;
+		output_sink out;
+
+		a.repr(out);
 
-		stream << std::boolalpha;
+		return out.text();
+	}
 
-		a.repr(stream);
+	void str(output_sink& out, const let& a) {
 
-		return stream.str();
+		if (a.type() == "format") {
+			/*
+				The 'format' data type must be printed using
+				its string representation, else it would only
+				impart its formating to the stream instead of
+				being printed to it.
+			*/
+			a.repr(out);
+		}
+		else {
+			a.str(out);
+		}
 	}
 
 	inline bool_type expression_is_empty(let expr) {
@@ -1411,4 +2300,953 @@ namespace Olly {
 		return n;
 	}
 
+	/********************************************************************************************/
+	//
+	//                              'let_allocator' Class Implementation
+	//
+	/********************************************************************************************/
+
+	let_allocator::~let_allocator() {
+	}
+
+	let_allocator* let_allocator::current() {
+		return installed();
+	}
+
+	let_allocator*& let_allocator::installed() {
+
+		static thread_local let_allocator* allocator = nullptr;
+
+		return allocator;
+	}
+
+	allocator_scope::allocator_scope(let_allocator* allocator) : _previous(let_allocator::installed()) {
+		let_allocator::installed() = allocator;
+	}
+
+	allocator_scope::~allocator_scope() {
+		let_allocator::installed() = _previous;
+	}
+
+	template <typename U>
+	hook_allocator<U>::hook_allocator(let_allocator* allocator) noexcept : _allocator(allocator) {
+	}
+
+	template <typename U>
+	template <typename V>
+	hook_allocator<U>::hook_allocator(const hook_allocator<V>& other) noexcept : _allocator(other._allocator) {
+	}
+
+	template <typename U>
+	U* hook_allocator<U>::allocate(std::size_t n) {
+
+		static_assert(alignof(U) <= alignof(std::max_align_t), "The type is aligned beyond what a let_allocator provides.");
+
+		return static_cast<U*>(_allocator->allocate(n * sizeof(U)));
+	}
+
+	template <typename U>
+	void hook_allocator<U>::deallocate(U* p, std::size_t n) noexcept {
+		_allocator->deallocate(p, n * sizeof(U));
+	}
+
+	template <typename U>
+	template <typename V>
+	bool_type hook_allocator<U>::operator==(const hook_allocator<V>& other) const noexcept {
+		return _allocator == other._allocator;
+	}
+
+	template <typename U>
+	template <typename V>
+	bool_type hook_allocator<U>::operator!=(const hook_allocator<V>& other) const noexcept {
+		return _allocator != other._allocator;
+	}
+
+	/********************************************************************************************/
+	//
+	//                              'object_pool' Class Implementation
+	//
+	/********************************************************************************************/
+
+	void* object_pool::allocate(size_type bytes) {
+
+		_lists_& l = lists();
+
+		size_type n = size_class(bytes);
+
+		l._counts.allocations += 1;
+		l._counts.bytes       += bytes;
+
+		std::ptrdiff_t net = static_cast<std::ptrdiff_t>(l._counts.bytes - l._counts.freed);
+
+		if (net > l._counts.rise) {
+			l._counts.rise = net;
+		}
+
+		if (n >= CLASSES) {
+
+			l._counts.heap += 1;
+
+			return ::operator new(bytes);
+		}
+
+		size_type size = (n + 1) * GRAIN;
+
+		if (!l._free[n]) {
+
+			if (l._retired) {
+				/*
+					The lists were returned as the thread ended, so
+					objects are taken straight from the depot.
+				*/
+
+				flush(l);
+
+				_depot_& d = depot();
+
+				std::lock_guard<std::mutex> guard(d._lock);
+
+				if (_free_* p = d._free[n]) {
+
+					d._free[n] = p->_next;
+					d._held[n].fetch_sub(1, std::memory_order_relaxed);
+
+					return p;
+				}
+
+				return ::operator new(size);
+			}
+
+			if (!l._active) {
+				join(l);
+			}
+
+			refill(l, n);
+		}
+
+		if (l._free[n]) {
+
+			_free_* p = l._free[n];
+
+			l._free[n]  = p->_next;
+			l._held[n] -= 1;
+
+			return p;
+		}
+
+		if (static_cast<size_type>(l._end - l._next) < size) {
+			take_block(l);
+		}
+
+		void* p = l._next;
+
+		l._next += size;
+
+		return p;
+	}
+
+	void object_pool::deallocate(void* p, size_type bytes) noexcept {
+
+		_lists_& l = lists();
+
+		size_type n = size_class(bytes);
+
+		l._counts.deallocations += 1;
+		l._counts.freed         += bytes;
+
+		if (n >= CLASSES) {
+
+			::operator delete(p);
+
+			return;
+		}
+
+		if (!l._active) {
+
+			if (l._retired) {
+
+				flush(l);
+
+				_depot_& d = depot();
+
+				std::lock_guard<std::mutex> guard(d._lock);
+
+				d._free[n] = new (p) _free_{ d._free[n] };
+				d._held[n].fetch_add(1, std::memory_order_relaxed);
+
+				return;
+			}
+
+			join(l);
+		}
+
+		l._free[n]  = new (p) _free_{ l._free[n] };
+		l._held[n] += 1;
+
+		if (l._held[n] * (n + 1) * GRAIN > BLOCK_SIZE) {
+			spill(l, n);
+		}
+	}
+
+	allocation_stats object_pool::stats() {
+
+		flush(lists());
+
+		_depot_& d = depot();
+
+		allocation_stats s;
+
+		s.allocations   = d.allocations.load(std::memory_order_relaxed);
+		s.deallocations = d.deallocations.load(std::memory_order_relaxed);
+		s.bytes         = d.bytes.load(std::memory_order_relaxed);
+		s.peak_bytes    = d.peak_bytes.load(std::memory_order_relaxed);
+		s.blocks        = d.blocks.load(std::memory_order_relaxed);
+		s.heap          = d.heap.load(std::memory_order_relaxed);
+
+		/*
+			Another thread may not yet have counted the objects
+			released here, so the live bytes are kept from wrapping.
+		*/
+
+		size_type freed = d.freed.load(std::memory_order_relaxed);
+
+		s.live_bytes = s.bytes > freed ? s.bytes - freed : 0;
+
+		if (s.live_bytes > s.peak_bytes) {
+			s.peak_bytes = s.live_bytes;
+		}
+
+		return s;
+	}
+
+	object_pool::_lists_& object_pool::lists() {
+		/*
+			The lists hold no destructor, so they remain usable
+			by values released while the thread is ending.  They
+			are returned to the depot by a separate object, made
+			as the thread first takes or releases a pooled object.
+		*/
+
+		static thread_local _lists_ l = {};
+
+		return l;
+	}
+
+	object_pool::_depot_& object_pool::depot() {
+
+		static _depot_* d = new _depot_();
+
+		return *d;
+	}
+
+	void object_pool::join(_lists_& l) {
+
+		static thread_local _retire_ retire;
+
+		l._active = true;
+	}
+
+	object_pool::_retire_::~_retire_() {
+
+		_lists_& l = lists();
+
+		flush(l);
+
+		_depot_& d = depot();
+
+		std::lock_guard<std::mutex> guard(d._lock);
+
+		for (size_type n = 0; n < CLASSES; ++n) {
+
+			if (!l._free[n]) {
+				continue;
+			}
+
+			_free_* last = l._free[n];
+
+			while (last->_next) {
+				last = last->_next;
+			}
+
+			last->_next = d._free[n];
+			d._free[n]  = l._free[n];
+
+			d._held[n].fetch_add(l._held[n], std::memory_order_relaxed);
+
+			l._free[n] = nullptr;
+			l._held[n] = 0;
+		}
+
+		/*
+			A remainder too small for the largest object is
+			dropped, as a span must fit any object cut from it.
+		*/
+
+		if (static_cast<size_type>(l._end - l._next) >= GRAIN * CLASSES) {
+			d._spans.emplace_back(l._next, l._end);
+		}
+
+		l._next    = nullptr;
+		l._end     = nullptr;
+		l._active  = false;
+		l._retired = true;
+	}
+
+	void object_pool::flush(_lists_& l) noexcept {
+
+		_counts_& c = l._counts;
+
+		if (!c.allocations && !c.deallocations) {
+			return;
+		}
+
+		_depot_& d = depot();
+
+		if (c.rise > 0) {
+
+			size_type live = d.bytes.load(std::memory_order_relaxed) - d.freed.load(std::memory_order_relaxed);
+			size_type peak = live + static_cast<size_type>(c.rise);
+			size_type seen = d.peak_bytes.load(std::memory_order_relaxed);
+
+			while (peak > seen && !d.peak_bytes.compare_exchange_weak(seen, peak, std::memory_order_relaxed)) {
+			}
+		}
+
+		d.allocations.fetch_add(c.allocations, std::memory_order_relaxed);
+		d.deallocations.fetch_add(c.deallocations, std::memory_order_relaxed);
+		d.bytes.fetch_add(c.bytes, std::memory_order_relaxed);
+		d.freed.fetch_add(c.freed, std::memory_order_relaxed);
+		d.blocks.fetch_add(c.blocks, std::memory_order_relaxed);
+		d.heap.fetch_add(c.heap, std::memory_order_relaxed);
+
+		c = {};
+	}
+
+	void object_pool::refill(_lists_& l, size_type n) {
+
+		_depot_& d = depot();
+
+		if (!d._held[n].load(std::memory_order_relaxed)) {
+			return;
+		}
+
+		flush(l);
+
+		std::lock_guard<std::mutex> guard(d._lock);
+
+		l._free[n] = d._free[n];
+		l._held[n] = d._held[n].exchange(0, std::memory_order_relaxed);
+
+		d._free[n] = nullptr;
+	}
+
+	void object_pool::spill(_lists_& l, size_type n) noexcept {
+		/*
+			Half the list is kept, so a thread which both takes
+			and releases objects does not return to the depot
+			at once.
+		*/
+
+		size_type keep = l._held[n] / 2;
+
+		_free_* last = l._free[n];
+
+		for (size_type i = 1; i < keep; ++i) {
+			last = last->_next;
+		}
+
+		_free_* first = last->_next;
+		_free_* end   = first;
+
+		while (end->_next) {
+			end = end->_next;
+		}
+
+		last->_next = nullptr;
+
+		flush(l);
+
+		_depot_& d = depot();
+
+		std::lock_guard<std::mutex> guard(d._lock);
+
+		end->_next = d._free[n];
+		d._free[n] = first;
+
+		d._held[n].fetch_add(l._held[n] - keep, std::memory_order_relaxed);
+
+		l._held[n] = keep;
+	}
+
+	void object_pool::take_block(_lists_& l) {
+		/*
+			Blocks are never freed, as any thread may hold an
+			object from any block upon its free lists.  They are
+			recorded so the memory remains reachable.
+		*/
+
+		flush(l);
+
+		_depot_& d = depot();
+
+		std::lock_guard<std::mutex> guard(d._lock);
+
+		if (!d._spans.empty()) {
+
+			l._next = d._spans.back().first;
+			l._end  = d._spans.back().second;
+
+			d._spans.pop_back();
+
+			return;
+		}
+
+		char* block = static_cast<char*>(::operator new(BLOCK_SIZE));
+
+		d._blocks.push_back(block);
+
+		l._next = block;
+		l._end  = block + BLOCK_SIZE;
+
+		l._counts.blocks += 1;
+	}
+
+	size_type object_pool::size_class(size_type bytes) {
+		return bytes ? (bytes - 1) / GRAIN : 0;
+	}
+
+	template <typename U>
+	pool_allocator<U>::pool_allocator() noexcept {
+	}
+
+	template <typename U>
+	template <typename V>
+	pool_allocator<U>::pool_allocator(const pool_allocator<V>& other) noexcept {
+	}
+
+	template <typename U>
+	U* pool_allocator<U>::allocate(std::size_t n) {
+
+		static_assert(alignof(U) <= alignof(std::max_align_t), "The type is aligned beyond what the object_pool provides.");
+
+		return static_cast<U*>(object_pool::allocate(n * sizeof(U)));
+	}
+
+	template <typename U>
+	void pool_allocator<U>::deallocate(U* p, std::size_t n) noexcept {
+		object_pool::deallocate(p, n * sizeof(U));
+	}
+
+	template <typename U>
+	template <typename V>
+	bool_type pool_allocator<U>::operator==(const pool_allocator<V>& other) const noexcept {
+		return true;
+	}
+
+	template <typename U>
+	template <typename V>
+	bool_type pool_allocator<U>::operator!=(const pool_allocator<V>& other) const noexcept {
+		return false;
+	}
+
+	template <typename T, typename... A>
+	std::shared_ptr<T> make_pooled(A&&... args) {
+
+		let_allocator* allocator = let_allocator::current();
+
+		if (allocator) {
+			return std::allocate_shared<T>(hook_allocator<T>(allocator), std::forward<A>(args)...);
+		}
+
+		return std::allocate_shared<T>(pool_allocator<T>(), std::forward<A>(args)...);
+	}
+
+	/********************************************************************************************/
+	//
+	//                                '_nesting_' Class Implementation
+	//
+	/********************************************************************************************/
+
+	_nesting_::_nesting_() : _depth(0), _base(0), _joining(false), _offsets(), _values(), _modes() {
+	}
+
+	template <typename F>
+	void _nesting_::write(str_type& buffer, const let& value, char mode, F write_here) {
+
+		if (_depth >= DEPTH_LIMIT) {
+
+			_offsets.emplace_back(buffer.size());
+			_values.emplace_back(value);
+			_modes.emplace_back(mode);
+
+			return;
+		}
+
+		if (!_depth) {
+			_base = buffer.size();
+		}
+
+		_depth += 1;
+
+		write_here(value, mode);
+
+		_depth -= 1;
+
+		if (_depth || _values.empty()) {
+			return;
+		}
+
+		size_type base = _base;
+
+		/*
+			Some values were set aside.  Each is written as a segment
+			of its own, which may set aside values in turn.  The text
+			written so far is kept aside while the segments are joined
+			upon it in order, and the buffer is used for each segment.
+		*/
+
+		str_type out;
+
+		out.swap(buffer);
+
+		std::vector<_segment_> stack(1);
+
+		stack.back()._text = out.substr(base);
+		stack.back()._next = 0;
+		stack.back()._pos  = 0;
+
+		out.resize(base);
+
+		for (size_type& offset : _offsets) {
+			offset -= base;
+		}
+
+		stack.back()._offsets.swap(_offsets);
+		stack.back()._values.swap(_values);
+		stack.back()._modes.swap(_modes);
+
+		_joining = true;
+
+		while (!stack.empty()) {
+
+			_segment_& s = stack.back();
+
+			if (s._next == s._values.size()) {
+
+				out.append(s._text, s._pos, str_type::npos);
+
+				stack.pop_back();
+
+				continue;
+			}
+
+			size_type offset = s._offsets[s._next];
+
+			out.append(s._text, s._pos, offset - s._pos);
+
+			s._pos = offset;
+
+			let  next      = std::move(s._values[s._next]);
+			char next_mode = s._modes[s._next];
+
+			s._next += 1;
+
+			_depth = 1;
+
+			write_here(next, next_mode);
+
+			_depth = 0;
+
+			_segment_ child;
+
+			child._text.swap(buffer);
+			child._offsets.swap(_offsets);
+			child._values.swap(_values);
+			child._modes.swap(_modes);
+			child._next = 0;
+			child._pos  = 0;
+
+			stack.emplace_back(std::move(child));
+		}
+
+		_joining = false;
+
+		buffer.swap(out);
+	}
+
+	bool_type _nesting_::holding() const {
+		return _joining || !_values.empty();
+	}
+
+	void _nesting_::flushed() {
+		_base = 0;
+	}
+
+	void _nesting_::clear() {
+
+		_depth   = 0;
+		_joining = false;
+
+		_offsets.clear();
+		_values.clear();
+		_modes.clear();
+	}
+
+	/********************************************************************************************/
+	//
+	//                        'output_sink' and 'file_sink' Class Implementation
+	//
+	/********************************************************************************************/
+
+	output_sink::output_sink() : _buffer(), _limit(static_cast<size_type>(-1)), _show_sign(false), _nesting() {
+	}
+
+	void output_sink::write_str(const let& value) {
+
+		_nesting.write(_buffer, value, 0, [this](const let& v, char mode) { mode ? v._self->_repr(*this) : v._self->_str(*this); });
+
+		if (_buffer.size() >= _limit && !_nesting.holding()) {
+			flush();
+			_nesting.flushed();
+		}
+	}
+
+	void output_sink::write_repr(const let& value) {
+
+		_nesting.write(_buffer, value, 1, [this](const let& v, char mode) { mode ? v._self->_repr(*this) : v._self->_str(*this); });
+
+		if (_buffer.size() >= _limit && !_nesting.holding()) {
+			flush();
+			_nesting.flushed();
+		}
+	}
+
+	output_sink::~output_sink() {
+	}
+
+	output_sink& output_sink::operator << (const str_type& text) {
+		append(text.data(), text.size());
+		return *this;
+	}
+
+	output_sink& output_sink::operator << (std::string_view text) {
+		append(text.data(), text.size());
+		return *this;
+	}
+
+	output_sink& output_sink::operator << (const char* text) {
+		append(text, std::strlen(text));
+		return *this;
+	}
+
+	output_sink& output_sink::operator << (char c) {
+		append(&c, 1);
+		return *this;
+	}
+
+	output_sink& output_sink::operator << (bool_type b) {
+		return b ? *this << "true" : *this << "false";
+	}
+
+	output_sink& output_sink::operator << (int_type n) {
+
+		char text[32];
+
+		append(text, std::snprintf(text, sizeof(text), _show_sign ? "%+lld" : "%lld", static_cast<long long>(n)));
+
+		return *this;
+	}
+
+	output_sink& output_sink::operator << (size_type n) {
+
+		char text[32];
+
+		append(text, std::snprintf(text, sizeof(text), "%llu", static_cast<unsigned long long>(n)));
+
+		return *this;
+	}
+
+	output_sink& output_sink::operator << (real_type n) {
+		/*
+			Reals are printed as a stream would print them by
+			default, to six significant digits.
+		*/
+
+		char text[64];
+
+		append(text, std::snprintf(text, sizeof(text), _show_sign ? "%+Lg" : "%Lg", n));
+
+		return *this;
+	}
+
+	output_sink& output_sink::operator << (double n) {
+		return *this << static_cast<real_type>(n);
+	}
+
+	output_sink& output_sink::operator << (const void* p) {
+
+		char text[32];
+
+		append(text, std::snprintf(text, sizeof(text), "%p", p));
+
+		return *this;
+	}
+
+	void output_sink::show_sign(bool_type show) {
+		_show_sign = show;
+	}
+
+	const str_type& output_sink::text() const {
+		return _buffer;
+	}
+
+	void output_sink::clear() {
+		_buffer.clear();
+	}
+
+	void output_sink::flush() {
+	}
+
+	void output_sink::append(const char* text, size_type n) {
+
+		_buffer.append(text, n);
+
+		if (_buffer.size() >= _limit && !_nesting.holding()) {
+			flush();
+			_nesting.flushed();
+		}
+	}
+
+	file_sink::file_sink(std::FILE* file) : output_sink(), _file(file) {
+		_limit = 1 << 16;
+	}
+
+	file_sink::~file_sink() {
+		flush();
+	}
+
+	void file_sink::flush() {
+
+		if (_file && !_buffer.empty()) {
+			std::fwrite(_buffer.data(), 1, _buffer.size(), _file);
+		}
+
+		_buffer.clear();
+	}
+
+	/********************************************************************************************/
+	//
+	//                                'hash_cache' Class Implementation
+	//
+	/********************************************************************************************/
+
+	hash_cache::hash_cache() : _value(0) {
+	}
+
+	hash_cache::hash_cache(const hash_cache& obj) : _value(0) {
+	}
+
+	hash_cache& hash_cache::operator = (const hash_cache& obj) {
+
+		_value.store(0, std::memory_order_relaxed);
+
+		return *this;
+	}
+
+	bool_type hash_cache::is() const {
+		return _value.load(std::memory_order_relaxed) != 0;
+	}
+
+	size_type hash_cache::get() const {
+		return _value.load(std::memory_order_relaxed);
+	}
+
+	size_type hash_cache::set(size_type hash) const {
+		/*
+			Zero marks a hash not yet computed, so a hash of
+			zero is kept as one instead.
+		*/
+
+		hash = hash ? hash : 1;
+
+		_value.store(hash, std::memory_order_relaxed);
+
+		return hash;
+	}
+
+	size_type hash_combine(size_type seed, size_type value) {
+		return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+	}
+
+	size_type hash_real(real_type n) {
+
+		if (n == 0) {
+			return 0;
+		}
+
+		return std::hash<real_type>()(n);
+	}
+
+	/********************************************************************************************/
+	//
+	//                          'encoder' and 'decoder' Class Implementation
+	//
+	/********************************************************************************************/
+
+	encoder::encoder() : _bytes(), _nesting(), _good(true) {
+	}
+
+	bool_type encoder::is() const {
+		return _good;
+	}
+
+	void encoder::fail() {
+		_good = false;
+	}
+
+	void encoder::write_value(const let& value) {
+		_nesting.write(_bytes, value, 0, [this](const let& v, char) { v._self->_encode(*this); });
+	}
+
+	void encoder::write_byte(unsigned char c) {
+		_bytes.push_back(static_cast<char>(c));
+	}
+
+	void encoder::write_kind(TYPE_KIND kind) {
+		write_byte(static_cast<unsigned char>(kind));
+	}
+
+	void encoder::write_size(size_type n) {
+		/*
+			Write seven bits at a time, with the high bit
+			set on each byte but the last.
+		*/
+
+		while (n >= 0x80) {
+
+			write_byte(static_cast<unsigned char>(n | 0x80));
+
+			n >>= 7;
+		}
+
+		write_byte(static_cast<unsigned char>(n));
+	}
+
+	void encoder::write_real(real_type n) {
+
+		char bytes[sizeof(real_type)] = {};
+
+		std::memcpy(bytes, &n, sizeof(real_type));
+
+		_bytes.append(bytes, sizeof(real_type));
+	}
+
+	void encoder::write_text(const str_type& text) {
+
+		write_size(text.size());
+
+		_bytes.append(text);
+	}
+
+	const str_type& encoder::bytes() const {
+		return _bytes;
+	}
+
+	void encoder::clear() {
+
+		_bytes.clear();
+		_nesting.clear();
+	}
+
+	decoder::decoder(const char* begin, const char* end) : _pos(begin), _end(end), _good(true) {
+	}
+
+	decoder::decoder(const str_type& bytes) : _pos(bytes.data()), _end(bytes.data() + bytes.size()), _good(true) {
+	}
+
+	bool_type decoder::is() const {
+		return _good;
+	}
+
+	bool_type decoder::at_end() const {
+		return _pos == _end;
+	}
+
+	void decoder::fail() {
+		_good = false;
+	}
+
+	unsigned char decoder::read_byte() {
+
+		if (_pos < _end) {
+			return static_cast<unsigned char>(*_pos++);
+		}
+
+		_good = false;
+
+		return 0;
+	}
+
+	TYPE_KIND decoder::read_kind() {
+		return static_cast<TYPE_KIND>(read_byte());
+	}
+
+	size_type decoder::read_size() {
+
+		size_type n = 0;
+
+		for (size_type shift = 0; shift < sizeof(size_type) * 8; shift += 7) {
+
+			unsigned char c = read_byte();
+
+			n |= static_cast<size_type>(c & 0x7F) << shift;
+
+			if (!(c & 0x80)) {
+				return n;
+			}
+		}
+
+		_good = false;
+
+		return 0;
+	}
+
+	real_type decoder::read_real() {
+
+		real_type n = 0.0;
+
+		if (static_cast<size_type>(_end - _pos) < sizeof(real_type)) {
+
+			_good = false;
+			_pos  = _end;
+
+			return n;
+		}
+
+		std::memcpy(&n, _pos, sizeof(real_type));
+
+		_pos += sizeof(real_type);
+
+		return n;
+	}
+
+	str_type decoder::read_text() {
+
+		size_type n = read_size();
+
+		if (static_cast<size_type>(_end - _pos) < n) {
+
+			_good = false;
+			_pos  = _end;
+
+			return "";
+		}
+
+		str_type text(_pos, n);
+
+		_pos += n;
+
+		return text;
+	}
+
 } // end Olly
\ No newline at end of file
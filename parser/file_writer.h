@@ -32,7 +32,8 @@ namespace Olly {
 	//                              'file_writer' class definition
 	//
 	//        The file_writer class opens a file and then is used to write text to the
-	//        file.
+	//        file.  A file opened as binary is instead written raw bytes, without any
+	//        translation of line endings.
 	//
 	/********************************************************************************************/
 
@@ -48,13 +49,14 @@ namespace Olly {
 
 	public:
 
-		file_writer(const str_type& inp);
+		file_writer(const str_type& inp, bool_type binary = false);
 		virtual ~file_writer();
 
 		bool_type is();
 
 		void write(const str_type& word);
 		void write_line(const str_type& word);
+		void write_bytes(const str_type& bytes);
 
 	private:
 		file_writer();
@@ -70,7 +72,8 @@ namespace Olly {
 	file_writer::file_writer() : _output(""), _stream(), _mutex(), _locked(false) {
 	}
 
-	file_writer::file_writer(const str_type& output_code) : _output(output_code, file_t::out), _stream(), _mutex(), _locked(_mutex.try_lock()) {
+	file_writer::file_writer(const str_type& output_code, bool_type binary) 
+		: _output(output_code, binary ? file_t::out | file_t::binary : file_t::out), _stream(), _mutex(), _locked(_mutex.try_lock()) {
 	}
 
 	file_writer::~file_writer() {
@@ -110,4 +113,12 @@ namespace Olly {
 		}
 	}
 
+	void file_writer::write_bytes(const str_type& bytes) {
+
+		if (_output.good()) {
+
+			_output.write(bytes.data(), bytes.size());
+		}
+	}
+
 } // end Olly
\ No newline at end of file
@@ -0,0 +1,334 @@
+#pragma once
+
+/********************************************************************************************/
+//
+//			Copyright 2019 Max J. Martin
+//
+//			This file is part of Oliver.
+//
+//			Oliver is free software : you can redistribute it and / or modify
+//			it under the terms of the GNU General Public License as published by
+//			the Free Software Foundation, either version 3 of the License, or
+//			(at your option) any later version.
+//
+//			Oliver is distributed in the hope that it will be useful,
+//			but WITHOUT ANY WARRANTY; without even the implied warranty of
+//			MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//			GNU General Public License for more details.
+//
+//			You should have received a copy of the GNU General Public License
+//			along with Oliver.If not, see < https://www.gnu.org/licenses/>.
+//
+/********************************************************************************************/
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <thread>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "parser.h"
+#include "value_stream.h"
+
+namespace Olly {
+
+	/********************************************************************************************/
+	//
+	//                              'module_cache' class definition
+	//
+	//        The module_cache class loads the compiled code of a script.  The binary
+	//        image of the code is kept within a cache directory, named by a hash of the
+	//        text of the script.  So a script unchanged since it was last run is read
+	//        back from its image, rather than parsed again.  Code which is not a file
+	//        is always parsed.
+	//
+	//        An image begins with a header identifying the format and the build which
+	//        wrote it.  An image which does not match is ignored and written again.
+	//
+	//        The hash of a script can be computed by anyone, so the images are kept
+	//        within a directory of the user's own, readable only by them.  Should the
+	//        directory or an image within it belong to another user, or be writable by
+	//        others, the cache is not used and the script is parsed.
+	//
+	/********************************************************************************************/
+
+	class module_cache {
+
+		typedef		std::filesystem::path		path_type;
+
+		path_type	_directory;
+
+	public:
+
+		module_cache();
+		module_cache(const str_type& directory);
+		virtual ~module_cache();
+
+		let load(const str_type& input);
+
+	private:
+
+		module_cache(const module_cache& obj) = delete;
+
+		static str_type   content_hash(const str_type& bytes);
+		static path_type  user_directory();
+		static bool_type  is_private(const path_type& path, bool_type directory);
+
+		bool_type  prepare_directory()                                                    const;
+
+		void       write_header(encoder& out, const str_type& hash)                       const;
+		bool_type   read_header(decoder& in, const str_type& hash)                        const;
+
+		bool_type    read_image(const path_type& image, const str_type& hash, let& code)  const;
+		void        write_image(const path_type& image, const str_type& hash, const let& code)  const;
+	};
+
+	static const str_type IMAGE_MAGIC("OLLY");
+
+	/********************************************************************************************/
+	//
+	//                               'module_cache' method definition
+	//
+	/********************************************************************************************/
+
+	module_cache::module_cache() : _directory(user_directory()) {
+	}
+
+	module_cache::module_cache(const str_type& directory) : _directory(directory) {
+	}
+
+	module_cache::~module_cache() {
+	}
+
+	let module_cache::load(const str_type& input) {
+		/*
+			Read the image of the file 'input' if one exists for
+			its current text.  Else parse the file, and write its
+			image for the next time it is loaded.
+		*/
+
+		str_type source;
+
+		if (_directory.empty() || !read_bytes(input, source) || !prepare_directory()) {
+
+			parser lex(input);
+
+			return lex.parse();
+		}
+
+		str_type  hash  = content_hash(source);
+		path_type image = _directory / (hash + ".olly");
+
+		let code;
+
+		if (read_image(image, hash, code)) {
+			return code;
+		}
+
+		{
+			parser lex(input);
+			code = lex.parse();
+		}
+
+		write_image(image, hash, code);
+
+		return code;
+	}
+
+	str_type module_cache::content_hash(const str_type& bytes) {
+		/*
+			A 64 bit FNV-1a hash of the text, as hexadecimal.
+		*/
+
+		unsigned long long hash = 14695981039346656037ull;
+
+		for (char c : bytes) {
+
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ull;
+		}
+
+		static const char digits[] = "0123456789abcdef";
+
+		str_type text(16, '0');
+
+		for (size_type i = 16; i > 0; i -= 1) {
+
+			text[i - 1] = digits[hash & 0xF];
+			hash >>= 4;
+		}
+
+		return text;
+	}
+
+	module_cache::path_type module_cache::user_directory() {
+		/*
+			The cache directory of the current user, or an empty
+			path if the user has none.
+		*/
+
+#ifdef _WIN32
+		const char* local = std::getenv("LOCALAPPDATA");
+
+		if (local && *local) {
+			return path_type(local) / "olly" / "cache";
+		}
+#else
+		const char* xdg = std::getenv("XDG_CACHE_HOME");
+
+		if (xdg && *xdg && path_type(xdg).is_absolute()) {
+			return path_type(xdg) / "olly";
+		}
+
+		const char* home = std::getenv("HOME");
+
+		if (home && *home && path_type(home).is_absolute()) {
+			return path_type(home) / ".cache" / "olly";
+		}
+#endif
+
+		return path_type();
+	}
+
+	bool_type module_cache::is_private(const path_type& path, bool_type directory) {
+		/*
+			Is the path a directory or regular file, rather than a link,
+			owned by the current user and writable by no one else.
+		*/
+
+#ifdef _WIN32
+		std::error_code error;
+
+		std::filesystem::file_status status = std::filesystem::symlink_status(path, error);
+
+		if (error) {
+			return false;
+		}
+
+		return directory ? std::filesystem::is_directory(status) : std::filesystem::is_regular_file(status);
+#else
+		struct stat info;
+
+		if (lstat(path.c_str(), &info) != 0) {
+			return false;
+		}
+
+		if (directory ? !S_ISDIR(info.st_mode) : !S_ISREG(info.st_mode)) {
+			return false;
+		}
+
+		return info.st_uid == geteuid() && (info.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+#endif
+	}
+
+	bool_type module_cache::prepare_directory() const {
+		/*
+			Create the cache directory if need be, accessible only
+			by its owner, and confirm it belongs to the current user.
+		*/
+
+		std::error_code error;
+
+		std::filesystem::create_directories(_directory, error);
+
+		if (error) {
+			return false;
+		}
+
+		if (!is_private(_directory, true)) {
+			return false;
+		}
+
+		std::filesystem::permissions(_directory, std::filesystem::perms::owner_all, std::filesystem::perm_options::replace, error);
+
+		return !error;
+	}
+
+	void module_cache::write_header(encoder& out, const str_type& hash) const {
+
+		write_format(out, IMAGE_MAGIC);
+		out.write_text(hash);
+	}
+
+	bool_type module_cache::read_header(decoder& in, const str_type& hash) const {
+
+		if (!read_format(in, IMAGE_MAGIC)) {
+			return false;
+		}
+
+		return in.read_text() == hash && in.is();
+	}
+
+	bool_type module_cache::read_image(const path_type& image, const str_type& hash, let& code) const {
+
+		str_type bytes;
+
+		if (!is_private(image, false) || !read_bytes(image.string(), bytes)) {
+			return false;
+		}
+
+		decoder in(bytes);
+
+		if (!read_header(in, hash)) {
+			return false;
+		}
+
+		let value = decode(in);
+
+		if (!in.is() || !in.at_end()) {
+			return false;
+		}
+
+		code = value;
+
+		return true;
+	}
+
+	void module_cache::write_image(const path_type& image, const str_type& hash, const let& code) const {
+		/*
+			Write the image to a file of its own first, then move it
+			into place.  So another process loading the same script
+			never reads an image which is only partly written.
+		*/
+
+		std::error_code error;
+
+		encoder out;
+
+		write_header(out, hash);
+		code.encode(out);
+
+		if (!out.is()) {
+			return;
+		}
+
+		size_type unique = std::hash<std::thread::id>()(std::this_thread::get_id())
+			             ^ static_cast<size_type>(std::chrono::steady_clock::now().time_since_epoch().count());
+
+		path_type temp = image;
+
+		temp += "." + std::to_string(unique) + ".tmp";
+
+		{
+			file_writer writer(temp.string(), true);
+
+			if (!writer.is()) {
+				return;
+			}
+
+			writer.write_bytes(out.bytes());
+		}
+
+		std::filesystem::rename(temp, image, error);
+
+		if (error) {
+			std::filesystem::remove(temp, error);
+		}
+	}
+
+} // end Olly
\ No newline at end of file
@@ -23,6 +23,7 @@
 
 #include <regex>
 #include <string>
+#include <vector>
 #include "token_reader.h"
 #include "text_reader.h"
 
@@ -47,12 +48,38 @@ namespace Olly {
 	// The regex below is currently not in use.  Will see later integration.  
 	// static const regex_t  REAL_REGEX("((\\+|-)?[[:digit:]]+)(\\.(([[:digit:]]+)?))?((e|E)((\\+|-)?)[[:digit:]]+)?", std::regex_constants::ECMAScript | std::regex_constants::optimize);
 
+	/********************************************************************************************/
+	//
+	//                                 'compile_frame' Definition
+	//
+	//        A compile frame is a single level of nesting within the code being
+	//        compiled.  A sequence frame gathers items until its closing token.
+	//        A lambda or prefix operator frame instead takes the items compiled
+	//        from the next one or two tokens, which may each open a sequence.
+	//
+	/********************************************************************************************/
+
+	enum class FRAME_KIND {
+		ROOT_FRAME = 0, EXPRESSION_FRAME, STATEMENT_FRAME, LIST_FRAME, SET_FRAME, LAMBDA_FRAME, PREFIX_FRAME
+	};
+
+	typedef		std::vector<let>		frame_items;
+
+	struct compile_frame {
+		FRAME_KIND      kind  = FRAME_KIND::ROOT_FRAME;
+		let             head  = let();      // The operator of a prefix frame, or the arguments of a lambda.
+		size_type      slots  = 0;          // The number of tokens left for a lambda or prefix frame to take.
+		frame_items    items  = frame_items();
+	};
+
+	typedef		std::vector<compile_frame>		frame_stack;
+
 	class parser {
 
 		typedef	char char_t;
 
 		text_reader			_input;    // The lexical code to parse.
-		tokens_type			_text;	   // The parsed code read from the input.
+		token_list			_tokens;   // The tokens read from the input, viewing its buffer.
 		bool_type				_skip;     // Identifies if a token exists within the bounds of a comment block.
 
 	public:
@@ -70,25 +97,35 @@ namespace Olly {
 		int_type  is_regex_escape_char(const char& c);
 		int_type  is_string_escape_char(const char& c);
 
-		void process_word(str_type& word);
+		void process_word(view_type word);
+		void process_token(TOKEN_KIND kind, view_type text);
 
-		str_type read_string();
-		str_type read_number();
-		str_type read_format();
-		str_type read_regex();
-		str_type list_op(const char& c);
-		str_type object_op(const char& c);
-		str_type expression_op(const char& c);
-		str_type closure_op(const char& c);
+		view_type read_string();
+		view_type read_number();
+		view_type read_format();
+		view_type read_regex();
+		view_type list_op(const char& c);
+		view_type object_op(const char& c);
+		view_type expression_op(const char& c);
+		view_type closure_op(const char& c);
 
 		void skip_comment_line();
 
 		bool_type whitespace_char(char_t c);
 
+		str_type decode_string(view_type text);
+		str_type decode_regex(view_type text);
+
 		let  compile();
-		void compile(str_type& word, token_reader& code, let& exp);
+		void compile(const token& word, frame_stack& frames);
+		void compile_word(view_type word, frame_items& items);
+
+		void place(frame_stack& frames, frame_items& items, view_type closer);
+		void close(frame_stack& frames, frame_items& items);
 
-		str_type collect_string(const str_type& stop, token_reader& code);
+		view_type closing_text(FRAME_KIND kind);
+
+		bool_type same_word(view_type word, view_type upper_case);
 	};
 
 
@@ -96,7 +133,7 @@ namespace Olly {
 	//                                'parser ' method definition
 	/********************************************************************************************/
 
-	parser::parser(str_type input) : _input(input), _text(), _skip() {
+	parser::parser(str_type input) : _input(input), _tokens(), _skip() {
 	}
 
 	parser::~parser() {
@@ -124,11 +161,13 @@ namespace Olly {
 			_input.next();
 		}
 
-		str_type  word;
+		/*
+			A word is always a contiguous run of characters within the
+			input, so it is held as a view and extended in place.  
+		*/
+		view_type word;
 		char_t c;
 
-		// _text.push_back("(");
-
 		while (_input.is()) {
 			/*
 				Grab each character and split each group
@@ -137,6 +176,8 @@ namespace Olly {
 				semantic meaning.
 			*/
 
+			const char_t* at = _input.position();
+
 			c = _input.next();
 
 			if (!whitespace_char(c)) {
@@ -145,17 +186,17 @@ namespace Olly {
 				*/
 
 				if (word == "-" && c != '-') {
-					_text.push_back("neg");
-					word = "";
+					process_word("neg");
+					word = view_type();
 				}
 				
 				if (word == "+" && c != '+') {
-					_text.push_back("abs");
-					word = "";
+					process_word("abs");
+					word = view_type();
 				}
 			}
 
-			if (whitespace_char(c) && word != "") {
+			if (whitespace_char(c) && !word.empty()) {
 				/*
 					If white space was encountered and
 					there is a defined word, process
@@ -164,7 +205,7 @@ namespace Olly {
 
 				process_word(word);
 
-				word = "";
+				word = view_type();
 			}
 
 			else if (c == ',' || c == '.') {
@@ -174,40 +215,25 @@ namespace Olly {
 				*/
 				if (word.size()) {
 					process_word(word);
-					word = "";
-				}
-
-				if (!_skip) {
-
-					if (c == '.') {
-						_text.push_back(".");
-					}
-					else {
-						_text.push_back(",");
-					}
+					word = view_type();
 				}
 
-				c = ' ';
+				process_word(view_type(at, 1));
 			}
 
 			else if (c == '"') {
 				/*
 					A string identification was encountered.
-					Process the string, and add it to _text
+					Process the string, and add it to the tokens
 					so long as we are not in a comment block.
 				*/
 
 				if (word.size()) {
 					process_word(word);
-					word = "";
+					word = view_type();
 				}
 
-				if (!_skip) {
-
-					_text.push_back("\"");
-					_text.push_back(read_string());
-					_text.push_back("\"");
-				}
+				process_token(TOKEN_KIND::STRING_TOKEN, read_string());
 			}
 
 			else if (c == '\'') {
@@ -217,97 +243,76 @@ namespace Olly {
 
 				if (word.size()) {
 					process_word(word);
-					word = "";
+					word = view_type();
 				}
 
-				if (!_skip) {
-
-					_text.push_back("\'");
-					_text.push_back(read_number());
-					_text.push_back("\'");
-				}
+				process_token(TOKEN_KIND::NUMBER_TOKEN, read_number());
 			}
 
 			else if (c == '\\') {
 				/*
 					A regex identification was encountered.
-					Process the regex, and add it to _text
+					Process the regex, and add it to the tokens
 					so long as we are not in a comment block.
 				*/
 
 				if (word.size()) {
 					process_word(word);
-					word = "";
+					word = view_type();
 				}
 
-				if (!_skip) {
-
-					_text.push_back("\\");
-					_text.push_back(read_regex());
-					_text.push_back("\\");
-				}
+				process_token(TOKEN_KIND::REGEX_TOKEN, read_regex());
 			}
 
 			else if (c == '`') {
 				/*
 					A format identification was encountered.
-					Process the format, and add it to _text
+					Process the format, and add it to the tokens
 					so long as we are not in a comment block.
 				*/
 
 				if (word.size()) {
 					process_word(word);
-					word = "";
+					word = view_type();
 				}
 
-				if (!_skip) {
-
-					_text.push_back("`");
-					_text.push_back(read_format());
-					_text.push_back("`");
-				}
+				process_token(TOKEN_KIND::FORMAT_TOKEN, read_format());
 			}
 
 			else if (c == '(' || c == ')') {
 				/*
 					An expression operator was encountered.
-					Process the expression, and add it to _text
+					Process the expression, and add it to the tokens
 					so long as we are not in a comment block.
 				*/
 
 				if (word.size()) {
 					process_word(word);
-					word = "";
+					word = view_type();
 				}
 
-				if (!_skip) {
-					_text.push_back(expression_op(c));
-				}
-
-				c = ' ';
+				process_word(expression_op(c));
 			}
 
 			else if (c == ':' || c == ';') {
 			/*
 				An expression operator was encountered.
-				Process the expression, and add it to _text
+				Process the expression, and add it to the tokens
 				so long as we are not in a comment block.
 			*/
 
 				if (word.size()) {
 					process_word(word);
-					word = "";
+					word = view_type();
 				}
 
 				if (!_skip) {
 					if (_input.peek() == '=') {
-						c = _input.next();
-						_text.push_back(":=");
-						c = ' ';
+						_input.next();
+						process_word(":=");
 					}
 					else {
-						_text.push_back(closure_op(c));
-						c = ' ';
+						process_word(closure_op(c));
 					}
 				}
 			}
@@ -315,44 +320,32 @@ namespace Olly {
 			else if (c == '[' || c == ']') {
 				/*
 					A list operator was encountered.
-					Process the list, and add it to _text
+					Process the list, and add it to the tokens
 					so long as we are not in a comment block
 				*/
 
 				if (word.size()) {
 					process_word(word);
-
-					if (word != "[") {
-						word = ".";
-						process_word(word);
-					}
-					word = "";
+					process_word(".");
+					word = view_type();
 				}
 
-				if (!_skip) {
-					_text.push_back(list_op(c));
-				}
-
-				c = ' ';
+				process_word(list_op(c));
 			}
 
 			else if (c == '{' || c == '}') {
 				/*
 					An object operator was encountered.
-					Process the object, and add it to _text
+					Process the object, and add it to the tokens
 					so long as we are not in a comment block
 				*/
 
 				if (word.size()) {
 					process_word(word);
-					word = "";
-				}
-
-				if (!_skip) {
-					_text.push_back(object_op(c));
+					word = view_type();
 				}
 
-				c = ' ';
+				process_word(object_op(c));
 			}
 
 			else if (c == '#') {
@@ -366,7 +359,7 @@ namespace Olly {
 				if (word.size()) {
 
 					process_word(word);
-					word = "";
+					word = view_type();
 				}
 
 				if (_input.peek() == '#') {
@@ -411,14 +404,20 @@ namespace Olly {
 
 			else if (!whitespace_char(c)) {
 				/*
-					Append any non white space char
-					to the word being formed.
+					Extend the word being formed over
+					any non white space char.
 				*/
-				word += c;
+
+				if (word.empty()) {
+					word = view_type(at, 1);
+				}
+				else {
+					word = view_type(word.data(), word.size() + 1);
+				}
 			}
 		}
 
-		if (word != "") {
+		if (!word.empty()) {
 			/*
 				Process any word left over after an
 				eof in the input code is encountered.
@@ -426,9 +425,7 @@ namespace Olly {
 			process_word(word);
 		}
 
-		// _text.push_back(")");
-
-		if (_text.empty()) {
+		if (_tokens.empty()) {
 			return expression();
 		}
 
@@ -470,71 +467,62 @@ namespace Olly {
 		return false;
 	}
 
-	void parser::process_word(str_type& word) {
+	void parser::process_word(view_type word) {
 		/*
 			Check that we are not within a comment block.
 			Else ensure we have a word to handle and place
-			it on the back of the text queue.
+			it on the back of the tokens.
 		*/
 
+		if (!word.empty()) {
+			process_token(TOKEN_KIND::WORD_TOKEN, word);
+		}
+	}
+
+	void parser::process_token(TOKEN_KIND kind, view_type text) {
+
 		if (_skip) {
 			return;
 		}
 
-		if (word != "") {
-			_text.push_back(word);
-		}
+		_tokens.push_back(token{ kind, text });
 	}
 
-	str_type parser::read_format() {
+	view_type parser::read_format() {
 		/*
 			Read each character including
-			whitespace and form a word to
-			be used to define a format
+			whitespace up to the closing '`'
+			to be used to define a format
 			object.
 		*/
 
-		str_type str;
-
-		char c;
+		const char_t* start = _input.position();
 
 		while (_input.is()) {
 
-			c = _input.next();
-
-			if (c == '`') {
-				break;
+			if (_input.next() == '`') {
+				return view_type(start, _input.position() - start - 1);
 			}
-
-			else {
-				str += c;
-			}
-		}
-
-		if (str.empty()) {
-			return "";
 		}
 
-		return str;
+		return view_type(start, _input.position() - start);
 	}
 
-	str_type parser::read_string() {
+	view_type parser::read_string() {
 		/*
 			Read each character including
-			whitespace and form a word to
-			be used to define a string of
+			whitespace up to the closing '"'
+			to be used to define a string of
 			characters.
 
 			When a '\' character is found
 			check to see if it is used to
 			define an escaped character.
-			If it is append the escaped
-			character to the string.
+			If it is the escaped character
+			cannot close the string.
 		*/
 
-		bool_type escaped = false;
-
-		str_type str;
+		const char_t* start = _input.position();
 
 		char c;
 
@@ -542,114 +530,51 @@ namespace Olly {
 
 			c = _input.next();
 
-			if (escaped) {
-
-				switch (c) {
-
-				case '\\':
-					str += '\\';
-					break;
-
-				case 'a':
-					str += '\a';
-					break;
-				
-				case 'b':
-					str += '\b';
-					break;
-				
-				case 'f':
-					str += '\f';
-					break;
-
-				case 'n': 
-					str += '\n';
-					break;
-
-				case 'r':
-					str += '\r';
-					break;
-
-				case 't':
-					str += '\t';
-					break;
-				
-				case 'v':
-					str += '\v';
-					break;
-				
-				default:
-					str += c;
-					break;
-				}
-
-				escaped = false;
-			}
-			else if ((c == '\\') && (is_string_escape_char(_input.peek()))) {
-
-				escaped = true;
+			if ((c == '\\') && (is_string_escape_char(_input.peek()))) {
+				_input.next();
 			}
 			else if (c == '"') {
-				break;
-			}
-			else {
-				str += c;
+				return view_type(start, _input.position() - start - 1);
 			}
 		}
 
-		return str;
+		return view_type(start, _input.position() - start);
 	}
 
-	str_type parser::read_number() {
+	view_type parser::read_number() {
 		/*
 			Read each character including
-			whitespace and form a word to
-			be used to define a string of
-			characters.
-
-			When a '\' character is found
-			check to see if it is used to
-			define an escaped character.
-			If it is append the escaped
-			character to the string.
+			whitespace up to the closing '\''
+			to be used to define a number.
 		*/
 
-		str_type str;
-
-		char c;
+		const char_t* start = _input.position();
 
 		while (_input.is()) {
 
-			c = _input.next();
-
-			if (c == '\'') {
-				break;
-			}
-			else {
-				str += c;
+			if (_input.next() == '\'') {
+				return view_type(start, _input.position() - start - 1);
 			}
 		}
 
-		return str;
+		return view_type(start, _input.position() - start);
 	}
 
-	str_type parser::read_regex() {
+	view_type parser::read_regex() {
 		/*
 			Read each character including
-			whitespace and form a word to
-			be used to define a regex of
+			whitespace up to the closing '\'
+			to be used to define a regex of
 			characters.
 
 			When a '\' character is found
 			check to see if it is used to
 			define an escaped character.
-			If it is append the escaped
-			character to the regex.
+			If it is the escaped character
+			cannot close the regex.
 		*/
 
-		bool_type escaped = false;
-
-		str_type str;
+		const char_t* start = _input.position();
 
 		char c;
 
@@ -657,33 +582,18 @@ namespace Olly {
 
 			c = _input.next();
 
-			if (escaped) {
-
-				if (c == '\\') {
-					str += '\\';
-				}
-				else {
-					str += c;
-				}
-
-				escaped = false;
-			}
-			else if ((c == '\\') && (is_string_escape_char(_input.peek()))) {
-
-				escaped = true;
+			if ((c == '\\') && (is_string_escape_char(_input.peek()))) {
+				_input.next();
 			}
-			else if (c == '\\' && !escaped) {
-				break;
-			}
-			else {
-				str += c;
+			else if (c == '\\') {
+				return view_type(start, _input.position() - start - 1);
 			}
 		}
 
-		return str;
+		return view_type(start, _input.position() - start);
 	}
 
-	str_type parser::list_op(const char& c) {
+	view_type parser::list_op(const char& c) {
 		/*
 			Validate which list operator is provided.
 		*/
@@ -695,7 +605,7 @@ namespace Olly {
 		return "]";
 	}
 
-	str_type parser::object_op(const char& c) {
+	view_type parser::object_op(const char& c) {
 		/*
 			Validate which object operator is provided.
 		*/
@@ -707,7 +617,7 @@ namespace Olly {
 		return "}";
 	}
 
-	str_type parser::expression_op(const char& c) {
+	view_type parser::expression_op(const char& c) {
 		/*
 			Validate which expression operator is provided.
 		*/
@@ -719,7 +629,7 @@ namespace Olly {
 		return ")";
 	}
 
-	str_type parser::closure_op(const char& c) {
+	view_type parser::closure_op(const char& c) {
 		/*
 			Validate which expression operator is provided.
 		*/
@@ -760,195 +670,435 @@ namespace Olly {
 		return false;
 	}
 
+	str_type parser::decode_string(view_type text) {
+		/*
+			Form the string of characters a string token
+			defines.  When a '\' character is found check
+			to see if it is used to define an escaped
+			character.  If it is append the escaped
+			character to the string.
+		*/
+
+		if (text.find('\\') == view_type::npos) {
+			return str_type(text);
+		}
+
+		bool_type escaped = false;
+
+		str_type str;
+
+		str.reserve(text.size());
+
+		for (size_type i = 0, stop = text.size(); i < stop; i += 1) {
+
+			char c = text[i];
+
+			if (escaped) {
+
+				switch (c) {
+
+				case '\\':
+					str += '\\';
+					break;
+
+				case 'a':
+					str += '\a';
+					break;
+				
+				case 'b':
+					str += '\b';
+					break;
+				
+				case 'f':
+					str += '\f';
+					break;
+
+				case 'n': 
+					str += '\n';
+					break;
+
+				case 'r':
+					str += '\r';
+					break;
+
+				case 't':
+					str += '\t';
+					break;
+				
+				case 'v':
+					str += '\v';
+					break;
+				
+				default:
+					str += c;
+					break;
+				}
+
+				escaped = false;
+			}
+			else if ((c == '\\') && (i + 1 < stop) && (is_string_escape_char(text[i + 1]))) {
+
+				escaped = true;
+			}
+			else {
+				str += c;
+			}
+		}
+
+		return str;
+	}
+
+	str_type parser::decode_regex(view_type text) {
+		/*
+			Form the regex of characters a regex token
+			defines, with each escaped character in
+			place of its escape sequence.
+		*/
+
+		bool_type escaped = false;
+
+		str_type str;
+
+		for (size_type i = 0, stop = text.size(); i < stop; i += 1) {
+
+			char c = text[i];
+
+			if (escaped) {
+
+				str += c;
+
+				escaped = false;
+			}
+			else if ((c == '\\') && (i + 1 < stop) && (is_string_escape_char(text[i + 1]))) {
+
+				escaped = true;
+			}
+			else {
+				str += c;
+			}
+		}
+
+		return str;
+	}
+
 	let parser::compile() {
+		/*
+			Compile the tokens with an explicit stack of frames rather
+			than by recursion, so the depth of nesting is not limited
+			by the stack of the interpreter.  Each frame gathers its
+			items in order, so no expression needs to be reversed.
+		*/
 
-		token_reader code(_text);
+		token_reader code(_tokens);
 
 		if (!code.is()) {
 			return expression();
 		}
 
-		str_type word;
-		let exp = expression();
+		frame_stack frames;
+		frame_items items;
+
+		frames.push_back(compile_frame{ FRAME_KIND::ROOT_FRAME });
 
 		while (code.is()) {
+			compile(code.next(), frames);
+		}
+
+		while (frames.size() > 1) {
+			/*
+				Close any frame left open at the end of the code.  A
+				frame awaiting a token is given nothing.
+			*/
 
-			word = code.next();
+			items.clear();
 
-			compile(word, code, exp);
+			if (frames.back().slots) {
+				place(frames, items, view_type());
+			}
+			else {
+				close(frames, items);
+			}
 		}
 
-		return exp.reverse();
+		return expression(frames.back().items);
 	}
 
-	void parser::compile(str_type& word, token_reader& code, let& exp) {
+	void parser::compile(const token& word, frame_stack& frames) {
+
+		frame_items items;
+
+		switch (word.kind) {
 
-		if (word == ")" || word == ";" || word == "]" || word == "}") {
+		case TOKEN_KIND::NOTHING_TOKEN:
+			place(frames, items, view_type());
 			return;
-		}
 
-		if (word == "\"") {
-			exp = exp.place_lead(string(collect_string("\"", code)));
+		case TOKEN_KIND::STRING_TOKEN:
+			items.push_back(string(decode_string(word.text)));
+			place(frames, items, view_type());
 			return;
-		}
 
-		if (word == "\'") {
-			exp = exp.place_lead(number(collect_string("\'", code)));
+		case TOKEN_KIND::NUMBER_TOKEN:
+			items.push_back(number(str_type(word.text)));
+			place(frames, items, view_type());
 			return;
+
+		case TOKEN_KIND::REGEX_TOKEN:
+			/*
+				Regex objects are not yet defined, so the
+				regex is compiled as a series of words.
+			*/
+			compile_word("\\", items);
+			compile_word(decode_regex(word.text), items);
+			compile_word("\\", items);
+			place(frames, items, view_type());
+			return;
+
+		case TOKEN_KIND::FORMAT_TOKEN:
+			/*
+				Format objects are not yet defined, so the
+				format is compiled as a series of words.
+			*/
+			compile_word("`", items);
+			compile_word(word.text, items);
+			compile_word("`", items);
+			place(frames, items, view_type());
+			return;
+
+		default:
+			break;
 		}
 
-		if (word == "lambda") {
-			
-			let args = expression();
-			word = code.next();
-			compile(word, code, args);
+		const view_type& text = word.text;
 
-			let body = expression();
-			word = code.next();
-			compile(word, code, body);
+		if (text == ")" || text == ";" || text == "]" || text == "}") {
+			place(frames, items, text);
+			return;
+		}
 
-			let l = lambda(args.lead(), body.lead());
+		if (text == "lambda") {
+			frames.push_back(compile_frame{ FRAME_KIND::LAMBDA_FRAME, let(), 2 });
+			return;
+		}
 
-			exp = exp.place_lead(l);
+		if (text == "(") {
+			frames.push_back(compile_frame{ FRAME_KIND::EXPRESSION_FRAME });
+			return;
+		}
 
+		if (text == ":") {
+			frames.push_back(compile_frame{ FRAME_KIND::STATEMENT_FRAME });
 			return;
 		}
 
-		if (word == "(") {
+		if (text == "[") {
+			frames.push_back(compile_frame{ FRAME_KIND::LIST_FRAME });
+			return;
+		}
 
-			let e = expression();
+		if (text == "{") {
+			frames.push_back(compile_frame{ FRAME_KIND::SET_FRAME });
+			return;
+		}
 
-			while (code.is() && word != ")") {
+		const operator_entry* entry = find_operator(text);
 
-				word = code.next();
+		if (entry) {
 
-				compile(word, code, e);
-			}
-			word = "";
+			let opr = op_call_value(entry->code);
 
-			exp = exp.place_lead(e.reverse());
+			if (entry->code < OP_CODE::PREFIX_UNARY_OPERATORS) {
+				/*
+					Handle prefix unary operators by placing the next code expression
+					and it within it own expression.  This ensures that binary operators
+					execute in the right order.  
+				*/
+				frames.push_back(compile_frame{ FRAME_KIND::PREFIX_FRAME, opr, 1 });
+				return;
+			}
 
+			items.push_back(opr);
+			place(frames, items, view_type());
 			return;
 		}
 
-		if (word == ":") {
+		compile_word(text, items);
+		place(frames, items, view_type());
+	}
+
+	void parser::place(frame_stack& frames, frame_items& items, view_type closer) {
+		/*
+			Place the items compiled from a single token within the
+			innermost frame.  A frame completed by them is closed and
+			its result placed within the frame around it in turn.
+
+			A closing token ends a frame which it matches.  When it is
+			the last token given to a lambda, it may also end the frame
+			around the lambda.
+		*/
 
-			let e = statement();
+		while (true) {
 
-			// e = e.place_lead(op_call(OP_CODE::begin_scope_op));
+			compile_frame& top = frames.back();
 
-			while (code.is() && word != ";") {
+			if (top.kind == FRAME_KIND::LAMBDA_FRAME) {
 
-				word = code.next();
+				let first = items.empty() ? let() : items.front();
 
-				compile(word, code, e);
-			}
-			word = "";
+				items.clear();
 
-			// e = e.place_lead(op_call(OP_CODE::end_scope_op));
+				if (top.slots == 2) {
 
-			exp = exp.place_lead(e.reverse());
+					top.head  = first;
+					top.slots = 1;
 
-			return;
-		}
+					return;
+				}
+
+				items.push_back(lambda(top.head, first));
+				frames.pop_back();
+
+				continue;
+			}
+
+			if (top.kind == FRAME_KIND::PREFIX_FRAME) {
 
-		if (word == "[") {
+				items.insert(items.begin(), top.head);
 
-			let e = expression();
+				let e = expression(items);
 
-			while (code.is() && word != "]") {
+				items.clear();
+				items.push_back(e);
+				frames.pop_back();
 
-				word = code.next();
+				closer = view_type();
 
-				compile(word, code, e);
+				continue;
 			}
-			word = "";
 
-			let l = list(e.reverse());
+			top.items.insert(top.items.end(), items.begin(), items.end());
 
-			exp = exp.place_lead(l);
+			items.clear();
+
+			if (closer.empty() || closer != closing_text(top.kind)) {
+				return;
+			}
+
+			close(frames, items);
 
 			return;
 		}
+	}
+
+	void parser::close(frame_stack& frames, frame_items& items) {
+		/*
+			Close the innermost frame, which gathers a sequence, and
+			place its result within the frame around it.
+		*/
 
-		if (word == "{") {
+		compile_frame top = std::move(frames.back());
 
-			let e = expression();
+		frames.pop_back();
 
-			while (code.is() && word != "}") {
+		items.clear();
 
-				word = code.next();
+		switch (top.kind) {
 
-				compile(word, code, e);
-			}
-			word = "";
+		case FRAME_KIND::EXPRESSION_FRAME:
+			items.push_back(expression(top.items));
+			break;
 
-			// exp = exp.place_lead(set(e));
+		case FRAME_KIND::STATEMENT_FRAME:
+			items.push_back(statement(top.items));
+			break;
 
-			return;
+		case FRAME_KIND::LIST_FRAME:
+			items.push_back(list(top.items));
+			break;
+
+		case FRAME_KIND::SET_FRAME:
+			items.push_back(set(expression(top.items)));
+			break;
+
+		default:
+			break;
 		}
 
-		if (word != "") {
+		place(frames, items, view_type());
+	}
 
-			auto it = OPERATORS.find(word);
+	view_type parser::closing_text(FRAME_KIND kind) {
 
-			if (it != OPERATORS.end()) {
+		switch (kind) {
 
-				let opr = op_call(it->second);
+		case FRAME_KIND::EXPRESSION_FRAME:
+			return ")";
 
-				if (it->second < OP_CODE::PREFIX_UNARY_OPERATORS) {
-					/*
-						Handle prefix unary operators by placing the next code expression
-						and it within it own expression.  This ensures that binary operators
-						execute in the right order.  
-					*/
-					let e = expression();
-					word = code.next();
-					compile(word, code, e);
-					word = "";
+		case FRAME_KIND::STATEMENT_FRAME:
+			return ";";
 
-					opr = e.place_lead(opr);
-				}
+		case FRAME_KIND::LIST_FRAME:
+			return "]";
 
-				exp = exp.place_lead(opr);
-				return;
-			}
+		case FRAME_KIND::SET_FRAME:
+			return "}";
+
+		default:
+			break;
+		}
+
+		return view_type();
+	}
+
+	void parser::compile_word(view_type word, frame_items& items) {
+		/*
+			Compile a word which is neither an operator nor
+			any of the delimiters, as a boolean or a symbol.
+		*/
+
+		if (word.empty()) {
+			return;
+		}
 
-			str_type upper_case = to_upper(word);
+		for (view_type literal : { "TRUE", "FALSE", "1", "0", "UNDEF", "UNDEFINED" }) {
 
-			if (upper_case == "TRUE"  || upper_case == "FALSE"    ||
-				upper_case == "1"     || upper_case == "0"        ||
-				upper_case == "UNDEF" || upper_case == "UNDEFINED") {
+			if (same_word(word, literal)) {
 
-				exp = exp.place_lead(boolean(upper_case));
+				items.push_back(boolean(str_type(literal)));
 				return;
 			}
+		}
 
-			if (upper_case == "ELSE") {
-				exp = exp.place_lead(boolean(true));
-			}
+		if (same_word(word, "ELSE")) {
+			items.push_back(boolean(true));
+			return;
+		}
 
-			else if (upper_case != "NOTHING") {
-				exp = exp.place_lead(symbol(word));
-			}
+		if (same_word(word, "NOTHING")) {
+			return;
 		}
-		return;
+
+		items.push_back(symbol(str_type(word)));
 	}
 
-	str_type parser::collect_string(const str_type& stop, token_reader& code) {
+	bool_type parser::same_word(view_type word, view_type upper_case) {
+		/*
+			Compare a word with an upper case reserved word,
+			ignoring the case of the word.
+		*/
 
-		str_type word = code.next();
-		str_type text = "";
+		if (word.size() != upper_case.size()) {
+			return false;
+		}
 
-		while (word != stop && word != "") {
+		for (size_type i = 0, stop = word.size(); i < stop; i += 1) {
 
-			if (word != "") {
-				text += word;
-				word = code.next();
+			if (::toupper(static_cast<unsigned char>(word[i])) != upper_case[i]) {
+				return false;
 			}
 		}
 
-		return text;
+		return true;
 	}
 
 } // end Olly
\ No newline at end of file
@@ -35,18 +35,21 @@ namespace Olly {
 	//        to the parser for evaluation.  If a valid file is not opened then the string
 	//        itself is iterated over for reading.  
 	//
+	//        The whole of the input is read into a buffer up front, in a single read for
+	//        a file, so moving to the next character is only a pointer increment.  
+	//
 	/********************************************************************************************/
 
 	class text_reader {
 
 		typedef		char						char_t;
-		typedef		std::fstream				file_t;
+		typedef		std::ifstream				file_t;
 		typedef		std::recursive_mutex		mutex_t;
 
-		char_t      _c;
-		file_t		_input;
-		bool_type      _file;
-		stream_type    _stream;
+		str_type       _buffer;
+		const char_t*     _pos;    // The current character.
+		const char_t*     _end;
+		bool_type        _file;
 		mutex_t		_mutex;
 		bool_type		_locked;
 
@@ -58,6 +61,8 @@ namespace Olly {
 		char_t next();
 		char_t peek();
 
+		const char_t* position() const;  // The address of the current character within the buffer.
+
 		str_type get_line();
 
 		bool_type is();
@@ -67,6 +72,8 @@ namespace Olly {
 	private:
 		text_reader();
 		text_reader(const text_reader& obj) = delete;
+
+		bool_type read_file(const str_type& file_name);
 	};
 
 	/********************************************************************************************/
@@ -75,39 +82,33 @@ namespace Olly {
 	//
 	/********************************************************************************************/
 
-	text_reader::text_reader() : _c('\0'), _input(""), _file(false), _stream(), _mutex(), _locked(false) {
+	text_reader::text_reader() : _buffer(), _pos(nullptr), _end(nullptr), _file(false), _mutex(), _locked(false) {
 	}
 
-	text_reader::text_reader(const str_type& input_code) : _c('\0'), _input(input_code, file_t::in), _file(true), _stream(), _mutex(), _locked(_mutex.try_lock()) {
+	text_reader::text_reader(const str_type& input_code) : _buffer(), _pos(nullptr), _end(nullptr), _file(true), _mutex(), _locked(_mutex.try_lock()) {
 		/*
-			Open a file 'file_name' and retrieve its first character
-			Setting the value of the character to '_c'.  So long as
+			Read the file 'file_name' into the buffer, and set the
+			current character to its first character.  So long as
 			the file is not empty.
 		*/
 
-
-		if (!_input.eof() && _input.good()) {
-
-			if (!_locked) {
-				return;
-			}
-
-			_c = _input.get();
-		}
-		else {
+		if (!read_file(input_code)) {
 			/*
-				Not a file, so send the text to a stream to be
-				treated just like a file.
+				Not a file, so the text itself is placed in the
+				buffer to be treated just like a file.
 			*/
 			_file = false;
-			_stream << input_code;
-
-			_c = _stream.get();
+			_buffer = input_code;
 		}
+		else if (!_locked) {
+			_buffer.clear();
+		}
+
+		_pos = _buffer.data();
+		_end = _pos + _buffer.size();
 	}
 
 	text_reader::~text_reader() {
-		_input.close();
 
 		if (_locked) {
 			_mutex.unlock();
@@ -116,24 +117,13 @@ namespace Olly {
 
 	text_reader::char_t text_reader::next() {
 		/*
-			As long as the file is not at the end of the file,
-			return the current value of '_c' and set the next
-			value of '_c'.  Return a null character if the
-			file is eof.
+			As long as the buffer is not at its end, return
+			the current character and move to the next.
+			Return a null character at the end of the buffer.
 		*/
 
-		if (is()) {
-
-			char_t t = _c;
-
-			if (_file) {
-				_input >> std::noskipws >> _c;
-			}
-			else {
-				_stream >> std::noskipws >> _c;
-			}
-
-			return t;
+		if (_pos < _end) {
+			return *_pos++;
 		}
 
 		return '\0';
@@ -141,27 +131,31 @@ namespace Olly {
 
 	text_reader::char_t text_reader::peek() {
 		/*
-			Return the current value of '_c'.
+			Return the current character.
 		*/
-		return _c;
+
+		if (_pos < _end) {
+			return *_pos;
+		}
+
+		return '\0';
+	}
+
+	const text_reader::char_t* text_reader::position() const {
+		return _pos;
 	}
 
 	bool_type text_reader::is() {
 		/*
-			Return true if the file is not eof
-			and in good condition.
+			Return true if the buffer is not at its end.
 		*/
 
-		if (_file) {
-			return (!_input.eof() && _input.good());
-		}
-		return (!_stream.eof() && _stream.good());
+		return _pos < _end;
 	}
 
 	bool_type text_reader::is_file() {
 		/*
-			Return true if the file is not eof
-			and in good condition.
+			Return true if the input was read from a file.
 		*/
 
 		return _file;
@@ -169,22 +163,59 @@ namespace Olly {
 
 	str_type text_reader::get_line() {
 
-		if (_file && !_input.eof() && _input.good()) {
+		if (_file && _pos < _end) {
 
-			str_type line;
+			const char_t* start = _pos;
 
-			std::getline(_input, line);
+			while (_pos < _end && *_pos != '\n') {
+				_pos += 1;
+			}
 
-			lrtrim(line);
+			str_type line(start, _pos);
 
-			if (line.empty()) {
-				return "";
+			if (_pos < _end) {
+				_pos += 1;
 			}
 
+			lrtrim(line);
+
 			return line;
 		}
 
 		return "";
 	}
 
+	bool_type text_reader::read_file(const str_type& file_name) {
+		/*
+			Read the whole of a file into the buffer, returning
+			false if it could not be opened.
+		*/
+
+		file_t input(file_name, file_t::in);
+
+		if (!input.good()) {
+			return false;
+		}
+
+		input.seekg(0, file_t::end);
+
+		std::streamoff size = input.tellg();
+
+		input.seekg(0, file_t::beg);
+
+		if (size > 0) {
+			/*
+				In text mode line endings may be translated, so fewer
+				characters than the size of the file may be read.
+			*/
+			_buffer.resize(static_cast<size_type>(size));
+
+			input.read(&_buffer[0], size);
+
+			_buffer.resize(static_cast<size_type>(input.gcount()));
+		}
+
+		return true;
+	}
+
 } // end Olly
\ No newline at end of file
@@ -21,15 +21,43 @@
 //			
 /********************************************************************************************/
 
+#include <string_view>
+#include <vector>
+
 #include "..\let.h"
 
 namespace Olly {
 
+	/********************************************************************************************/
+	//
+	//                                    'token' Definition
+	//
+	//        A token is a compact record of a single lexical element.  Its text is a
+	//        view into the source buffer held by the text_reader, or into a literal,
+	//        so no text is copied when the code is split into tokens.  The text of
+	//        a string, number, regex, or format token excludes its delimiters, and
+	//        any escaped characters within it are left to be decoded on compilation.
+	//
+	/********************************************************************************************/
+
+	enum class TOKEN_KIND {
+		NOTHING_TOKEN = 0, WORD_TOKEN, STRING_TOKEN, NUMBER_TOKEN, REGEX_TOKEN, FORMAT_TOKEN
+	};
+
+	typedef		std::string_view		view_type;
+
+	struct token {
+		TOKEN_KIND   kind;
+		view_type    text;
+	};
+
+	typedef		std::vector<token>		token_list;
+
 	/********************************************************************************************/
 	//
 	//                              'token_reader' class definition
 	//
-	//        The token_reader class simply manages iteration over a series of text tokens.
+	//        The token_reader class simply manages iteration over a series of tokens.
 	//
 	/********************************************************************************************/
 
@@ -37,18 +65,20 @@ namespace Olly {
 
 	public:
 
-		token_reader(const tokens_type& input_code);
+		token_reader(const token_list& input_code);
 		virtual ~token_reader();
 
-		str_type next();
-		str_type peek();
+		const token& next();
+		const token& peek();
 
 		bool_type is();
 
 	private:
 
-		const tokens_type& _code;
-		tokens_type::const_iterator	_i;
+		const token_list& _code;
+		token_list::const_iterator	_i;
+
+		static const token  _nothing;
 
 		token_reader() = delete;
 		token_reader(const token_reader& obj) = delete;
@@ -60,41 +90,42 @@ namespace Olly {
 	//
 	/********************************************************************************************/
 
-	token_reader::token_reader(const tokens_type& input_code) : _code(input_code), _i() {
+	const token token_reader::_nothing = { TOKEN_KIND::NOTHING_TOKEN, view_type() };
 
-		if (!_code.empty()) {
-			_i = _code.cbegin();
-		}
+	token_reader::token_reader(const token_list& input_code) : _code(input_code), _i(_code.cbegin()) {
 	}
 
 	token_reader::~token_reader() {
 	}
 
-	str_type token_reader::next() {
+	const token& token_reader::next() {
+		/*
+			Return the current token and move to the next.
+			Return an empty token once all have been read.
+		*/
 
 		if (is()) {
-
-			str_type t = *_i;
-
-			++_i;
-
-			return t;
+			return *_i++;
 		}
 
-		return "";
+		return _nothing;
 	}
 
-	str_type token_reader::peek() {
+	const token& token_reader::peek() {
 		/*
-			Return the current value of '_c'.
+			Return the current token.
 		*/
-		return *_i;
+
+		if (is()) {
+			return *_i;
+		}
+
+		return _nothing;
 	}
 
 	bool_type token_reader::is() {
 		/*
-			Return true if the file is not eof
-			and in good condition.
+			Return true if there are tokens left to read.
 		*/
 		return (_i != _code.cend());
 	}
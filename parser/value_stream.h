@@ -0,0 +1,254 @@
+#pragma once
+
+/********************************************************************************************/
+//
+//			Copyright 2019 Max J. Martin
+//
+//			This file is part of Oliver.
+//
+//			Oliver is free software : you can redistribute it and / or modify
+//			it under the terms of the GNU General Public License as published by
+//			the Free Software Foundation, either version 3 of the License, or
+//			(at your option) any later version.
+//
+//			Oliver is distributed in the hope that it will be useful,
+//			but WITHOUT ANY WARRANTY; without even the implied warranty of
+//			MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//			GNU General Public License for more details.
+//
+//			You should have received a copy of the GNU General Public License
+//			along with Oliver.If not, see < https://www.gnu.org/licenses/>.
+//
+/********************************************************************************************/
+
+#include <filesystem>
+#include <fstream>
+
+#include "file_writer.h"
+#include "..\eval\types_header.h"
+
+namespace Olly {
+
+	/********************************************************************************************/
+	//
+	//                                  Binary File Functions
+	//
+	//        Every binary file begins with a short header, a magic word followed by the
+	//        version of the format, the size of a real and a hash of the operator codes.
+	//        A value is only read back by a build which agrees on each.
+	//
+	/********************************************************************************************/
+
+	static const size_type BINARY_VERSION = 2;
+
+	bool_type read_bytes(const str_type& file_name, str_type& bytes);     // Read the whole of a file.
+
+	void      write_format(encoder& out, const str_type& magic);
+	bool_type  read_format(decoder& in, const str_type& magic);
+
+	bool_type read_bytes(const str_type& file_name, str_type& bytes) {
+		/*
+			Read the whole of a file in a single read.  Return
+			false if it is not a file which could be opened.
+		*/
+
+		std::error_code error;
+
+		if (!std::filesystem::is_regular_file(file_name, error)) {
+			return false;
+		}
+
+		std::ifstream input(file_name, std::ios::in | std::ios::binary);
+
+		if (!input.good()) {
+			return false;
+		}
+
+		input.seekg(0, std::ios::end);
+
+		std::streamoff size = input.tellg();
+
+		input.seekg(0, std::ios::beg);
+
+		bytes.clear();
+
+		if (size > 0) {
+
+			bytes.resize(static_cast<size_type>(size));
+
+			input.read(&bytes[0], size);
+
+			bytes.resize(static_cast<size_type>(input.gcount()));
+		}
+
+		return true;
+	}
+
+	void write_format(encoder& out, const str_type& magic) {
+
+		out.write_text(magic);
+		out.write_size(BINARY_VERSION);
+		out.write_size(sizeof(real_type));
+		out.write_size(OP_CODE_HASH);
+	}
+
+	bool_type read_format(decoder& in, const str_type& magic) {
+
+		if (in.read_text() != magic) {
+			return false;
+		}
+
+		if (in.read_size() != BINARY_VERSION) {
+			return false;
+		}
+
+		if (in.read_size() != sizeof(real_type)) {
+			return false;
+		}
+
+		return in.read_size() == OP_CODE_HASH && in.is();
+	}
+
+	/********************************************************************************************/
+	//
+	//                              'value_writer' class definition
+	//
+	//        The value_writer class writes a series of values to a binary file.  Each
+	//        value is encoded and passed straight on to the file_writer, so a series
+	//        of any length is written without being held in memory.
+	//
+	/********************************************************************************************/
+
+	static const str_type VALUES_MAGIC("OLLV");
+
+	class value_writer {
+
+		file_writer	_output;
+		encoder		_buffer;
+
+	public:
+
+		value_writer(const str_type& file_name);
+		virtual ~value_writer();
+
+		bool_type is();
+
+		void write(const let& value);
+
+	private:
+		value_writer();
+		value_writer(const value_writer& obj) = delete;
+	};
+
+	/********************************************************************************************/
+	//
+	//                              'value_reader' class definition
+	//
+	//        The value_reader class reads back the values of a file written by the
+	//        value_writer, in the order they were written.
+	//
+	/********************************************************************************************/
+
+	class value_reader {
+
+		str_type	_bytes;
+		decoder		_input;
+		bool_type	_valid;
+
+	public:
+
+		value_reader(const str_type& file_name);
+		virtual ~value_reader();
+
+		bool_type is();
+
+		let next();
+
+	private:
+		value_reader();
+		value_reader(const value_reader& obj) = delete;
+	};
+
+	/********************************************************************************************/
+	//
+	//                               'value_writer' method definition
+	//
+	/********************************************************************************************/
+
+	value_writer::value_writer(const str_type& file_name) : _output(file_name, true), _buffer() {
+
+		write_format(_buffer, VALUES_MAGIC);
+
+		_output.write_bytes(_buffer.bytes());
+		_buffer.clear();
+	}
+
+	value_writer::~value_writer() {
+	}
+
+	bool_type value_writer::is() {
+		return _output.is() && _buffer.is();
+	}
+
+	void value_writer::write(const let& value) {
+		/*
+			Once a value is met with no binary form, it and every
+			value after it are left out, and the writer is no
+			longer good.
+		*/
+
+		value.encode(_buffer);
+
+		if (!_buffer.is()) {
+			_buffer.clear();
+			return;
+		}
+
+		_output.write_bytes(_buffer.bytes());
+		_buffer.clear();
+	}
+
+	/********************************************************************************************/
+	//
+	//                               'value_reader' method definition
+	//
+	/********************************************************************************************/
+
+	value_reader::value_reader(const str_type& file_name) : _bytes(), _input(nullptr, nullptr), _valid(false) {
+
+		if (read_bytes(file_name, _bytes)) {
+
+			_input = decoder(_bytes);
+			_valid = read_format(_input, VALUES_MAGIC);
+		}
+	}
+
+	value_reader::~value_reader() {
+	}
+
+	bool_type value_reader::is() {
+		/*
+			Return true while there are values left to read
+			and the file has not been found malformed.
+		*/
+
+		return _valid && _input.is() && !_input.at_end();
+	}
+
+	let value_reader::next() {
+
+		if (!is()) {
+			return nothing();
+		}
+
+		let value = decode(_input);
+
+		if (!_input.is()) {
+			_valid = false;
+			return nothing();
+		}
+
+		return value;
+	}
+
+} // end Olly
\ No newline at end of file
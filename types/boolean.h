@@ -50,15 +50,25 @@ namespace Olly {
 		boolean(const int_type& n, real_type t = 1.0);
 		boolean(const bool_type& n, real_type t = 1.0);
 		boolean(const real_type& n, real_type t = 1.0);
-		virtual ~boolean();
+		~boolean();
 
 		friend str_type         _type_(const boolean& self);
+		friend TYPE_KIND        _kind_(const boolean& self);
 		friend bool_type          _is_(const boolean& self);
 		friend real_type        _comp_(const boolean& self, const let& other);
-		friend void           _str_(stream_type& out, const boolean& self);
-		friend void          _repr_(stream_type& out, const boolean& self);
+		friend std::size_t      _hash_(const boolean& self);
+		friend void           _str_(output_sink& out, const boolean& self);
+		friend void          _repr_(output_sink& out, const boolean& self);
+		friend void        _encode_(encoder& out, const boolean& self);
 	};
 
+	template <>
+	struct inline_storage<boolean> {
+		static const bool_type value = true;
+	};
+
+	static_assert(let::is_inline<boolean>(), "A boolean must fit within let::INLINE_SIZE.");
+
 
 	boolean::boolean() : _term(0.0), _weight(1.0) {
 	}
@@ -128,6 +138,10 @@ namespace Olly {
 		return "boolean";
 	}
 
+	TYPE_KIND _kind_(const boolean& self) {
+		return TYPE_KIND::BOOLEAN_TYPE;
+	}
+
 	bool _is_(const boolean& self) {
 		return self._term >= self._weight;
 	}
@@ -155,7 +169,11 @@ namespace Olly {
 		return NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const boolean& self) {
+	std::size_t _hash_(const boolean& self) {
+		return hash_combine(static_cast<std::size_t>(TYPE_KIND::BOOLEAN_TYPE), _is_(self));
+	}
+
+	void _str_(output_sink& out, const boolean& self) {
 
 		if (self._term != self._term) {
 
@@ -167,9 +185,15 @@ namespace Olly {
 		out << _is_(self);
 	}
 
-	void _repr_(stream_type& out, const boolean& self) {
+	void _repr_(output_sink& out, const boolean& self) {
 
 		out << "('" << self._term << "' '" << self._weight << "' BOOL)";
 	}
 
+	void _encode_(encoder& out, const boolean& self) {
+		out.write_kind(TYPE_KIND::BOOLEAN_TYPE);
+		out.write_real(self._term);
+		out.write_real(self._weight);
+	}
+
 } // end
\ No newline at end of file
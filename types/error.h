@@ -44,14 +44,19 @@ namespace Olly {
 
 		error();
 		error(const error& obj);
+		error(error&& obj) noexcept;
 		error(str_type val);
 		virtual ~error();
 
 		friend str_type       _type_(const error& self);
+		friend TYPE_KIND      _kind_(const error& self);
 		friend bool          _is_(const error& self);
 		friend real_type      _comp_(const error& self, const let& other);
-		friend void         _str_(stream_type& out, const error& self);
-		friend void        _repr_(stream_type& out, const error& self);
+		friend std::size_t    _hash_(const error& self);
+		friend void         _str_(output_sink& out, const error& self);
+		friend void        _repr_(output_sink& out, const error& self);
+		friend void      _encode_(encoder& out, const error& self);
+		friend let     copy_value(const let& value, const let_allocator* from);
 	};
 
 
@@ -61,6 +66,9 @@ namespace Olly {
 	error::error(const error& obj) : _value(obj._value) {
 	}
 
+	error::error(error&& obj) noexcept : _value(std::move(obj._value)) {
+	}
+
 	error::error(str_type val) :  _value(val) {
 	}
 
@@ -71,6 +79,10 @@ namespace Olly {
 		return "ERROR";
 	}
 
+	TYPE_KIND _kind_(const error& self) {
+		return TYPE_KIND::ERROR_TYPE;
+	}
+
 	bool _is_(const error& self) {
 		return !self._value.empty();
 	}
@@ -94,13 +106,22 @@ namespace Olly {
 		return NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const error& self) {
+	std::size_t _hash_(const error& self) {
+		return hash_combine(static_cast<std::size_t>(TYPE_KIND::ERROR_TYPE), DEFAULT_HASH_FUNCTION(self._value));
+	}
+
+	void _str_(output_sink& out, const error& self) {
 		out << self._value;
 	}
 
-	void _repr_(stream_type& out, const error& self) {
+	void _repr_(output_sink& out, const error& self) {
 		_str_(out, self);
 		out << "ERROR";
 	}
+
+	void _encode_(encoder& out, const error& self) {
+		out.write_kind(TYPE_KIND::ERROR_TYPE);
+		out.write_text(self._value);
+	}
 	
 } // end
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "..\let.h"
+#include "support\vector.h"
 
 namespace Olly {
 
@@ -45,6 +46,7 @@ namespace Olly {
 
 		_node_();
 		_node_(const _node_& exp);
+		_node_(_node_&& exp) noexcept;
 		_node_(let obj);
 		virtual ~_node_();
 
@@ -52,8 +54,8 @@ namespace Olly {
 		friend bool_type            _is_(const _node_& self);
 		friend real_type          _comp_(const _node_& self, const let& other);
 
-		friend void                _str_(stream_type& out, const _node_& self);
-		friend void               _repr_(stream_type& out, const _node_& self);
+		friend void                _str_(output_sink& out, const _node_& self);
+		friend void               _repr_(output_sink& out, const _node_& self);
 
 		friend size_type          _size_(const _node_& self);
 		friend let                _lead_(const _node_& self);
@@ -77,7 +79,10 @@ namespace Olly {
 	_node_::_node_(const _node_& exp) : _data(exp._data), _next(exp._next) {
 	}
 
-	_node_::_node_(let object) : _data(object), _next() {
+	_node_::_node_(_node_&& exp) noexcept : _data(std::move(exp._data)), _next(std::move(exp._next)) {
+	}
+
+	_node_::_node_(let object) : _data(std::move(object)), _next() {
 	}
 
 	_node_::~_node_() {
@@ -123,7 +128,7 @@ namespace Olly {
 		return NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const _node_& self) {
+	void _str_(output_sink& out, const _node_& self) {
 
 		if (!_is_(self)) {
 			return;
@@ -134,7 +139,7 @@ namespace Olly {
 		bool_type next = false;
 
 		do {
-			out << str(e.lead());
+			str(out, e.lead());
 
 			e = e.shift_lead();
 
@@ -147,7 +152,7 @@ namespace Olly {
 		} while (next);
 	}
 
-	void _repr_(stream_type& out, const _node_& self) {
+	void _repr_(output_sink& out, const _node_& self) {
 
 		if (!_is_(self)) {
 			return;
@@ -158,7 +163,7 @@ namespace Olly {
 		bool_type next = false;
 
 		do {
-			out << repr(e.lead());
+			e.lead().repr(out);
 
 			e = e.shift_lead();
 
@@ -327,6 +332,7 @@ namespace Olly {
 
 		_node_expr_();
 		_node_expr_(const _node_expr_& exp);
+		_node_expr_(_node_expr_&& exp) noexcept;
 		_node_expr_(let x);
 		_node_expr_(let x, let y);
 		virtual ~_node_expr_();
@@ -335,8 +341,8 @@ namespace Olly {
 		friend bool_type            _is_(const _node_expr_& self);
 		friend real_type          _comp_(const _node_expr_& self, const let& other);
 
-		friend void                _str_(stream_type& out, const _node_expr_& self);
-		friend void               _repr_(stream_type& out, const _node_expr_& self);
+		friend void                _str_(output_sink& out, const _node_expr_& self);
+		friend void               _repr_(output_sink& out, const _node_expr_& self);
 
 		friend size_type          _size_(const _node_expr_& self);
 		friend let                _lead_(const _node_expr_& self);
@@ -359,7 +365,10 @@ namespace Olly {
 	_node_expr_::_node_expr_(const _node_expr_& exp) : _queue(exp._queue), _len(exp._len) {
 	}
 
-	_node_expr_::_node_expr_(let x) : _queue(_node_(x)), _len(0) {
+	_node_expr_::_node_expr_(_node_expr_&& exp) noexcept : _queue(std::move(exp._queue)), _len(exp._len) {
+	}
+
+	_node_expr_::_node_expr_(let x) : _queue(_node_(std::move(x))), _len(0) {
 		if (_queue.is()) {
 			_len = 1;
 		}
@@ -410,12 +419,12 @@ namespace Olly {
 		return NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const _node_expr_& self) {
+	void _str_(output_sink& out, const _node_expr_& self) {
 
 		self._queue.str(out);
 	}
 
-	void _repr_(stream_type& out, const _node_expr_& self) {
+	void _repr_(output_sink& out, const _node_expr_& self) {
 
 		self._queue.repr(out);
 	}
@@ -495,28 +504,37 @@ namespace Olly {
 
 	class expression {
 
-		let        _expr;
+		_vector_   _expr;
 
 	public:
 
 		expression();
 		expression(const expression& exp);
+		expression(expression&& exp) noexcept;
 		expression(let x);
 		expression(let x, let y);
+		expression(const std::vector<let>& items);
+		expression(const _vector_& items);
 		virtual ~expression();
 
 		friend str_type           _type_(const expression& self);
+		friend TYPE_KIND          _kind_(const expression& self);
 		friend bool_type            _is_(const expression& self);
 		friend real_type          _comp_(const expression& self, const let& other);
+		friend std::size_t        _hash_(const expression& self);
 
-		friend void                _str_(stream_type& out, const expression& self);
-		friend void               _repr_(stream_type& out, const expression& self);
+		friend void                _str_(output_sink& out, const expression& self);
+		friend void               _repr_(output_sink& out, const expression& self);
+		friend void             _encode_(encoder& out, const expression& self);
+		friend let            copy_value(const let& value, const let_allocator* from);
 
 		friend size_type          _size_(const expression& self);
 		friend let                _lead_(const expression& self);
 		friend let                _last_(const expression& self);
 		friend let          _place_lead_(const expression& self, const let& other);
 		friend let          _shift_lead_(const expression& self);
+		friend let          _place_last_(const expression& self, const let& other);
+		friend let          _shift_last_(const expression& self);
 		friend let             _reverse_(const expression& self);
 	};
 
@@ -526,16 +544,27 @@ namespace Olly {
 	//
 	/********************************************************************************************/
 
-	expression::expression() : _expr(_node_expr_()) {
+	expression::expression() : _expr() {
 	}
 
 	expression::expression(const expression& exp) : _expr(exp._expr) {
 	}
 
-	expression::expression(let x) : _expr(_node_expr_(x)) {
+	expression::expression(expression&& exp) noexcept : _expr(std::move(exp._expr)) {
+	}
+
+	expression::expression(let x) : _expr() {
+		_expr = _expr.place_last(std::move(x));
 	}
 
-	expression::expression(let x, let y) : _expr(_node_expr_(x, y)) {
+	expression::expression(let x, let y) : _expr() {
+		_expr = _expr.place_last(std::move(x)).place_last(std::move(y));
+	}
+
+	expression::expression(const std::vector<let>& items) : _expr(items) {
+	}
+
+	expression::expression(const _vector_& items) : _expr(items) {
 	}
 
 	expression::~expression() {
@@ -545,6 +574,10 @@ namespace Olly {
 		return "expression";
 	}
 
+	TYPE_KIND _kind_(const expression& self) {
+		return TYPE_KIND::EXPRESSION_TYPE;
+	}
+
 	bool_type _is_(const expression& self) {
 
 		return self._expr.is();
@@ -552,10 +585,20 @@ namespace Olly {
 
 	real_type _comp_(const expression& self, const let& other) {
 
-		return self._expr.comp(other);
+		const expression* e = other.cast<expression>();
+
+		if (e) {
+			return self._expr.comp(e->_expr);
+		}
+
+		return NOT_A_NUMBER;
+	}
+
+	std::size_t _hash_(const expression& self) {
+		return hash_combine(static_cast<std::size_t>(TYPE_KIND::EXPRESSION_TYPE), self._expr.hash());
 	}
 
-	void _str_(stream_type& out, const expression& self) {
+	void _str_(output_sink& out, const expression& self) {
 
 		if (!_is_(self)) {
 			out << "()";
@@ -569,7 +612,7 @@ namespace Olly {
 		out << ")";
 	}
 
-	void _repr_(stream_type& out, const expression& self) {
+	void _repr_(output_sink& out, const expression& self) {
 
 		if (!_is_(self)) {
 			out << "()";
@@ -583,6 +626,11 @@ namespace Olly {
 		out << ")";
 	}
 
+	void _encode_(encoder& out, const expression& self) {
+		out.write_kind(TYPE_KIND::EXPRESSION_TYPE);
+		self._expr.encode(out);
+	}
+
 	size_type _size_(const expression& self) {
 
 		return self._expr.size();
@@ -624,6 +672,32 @@ namespace Olly {
 		return e;
 	}
 
+	let _place_last_(const expression& self, const let& other) {
+
+		if (other.is_nothing()) {
+			return self;
+		}
+
+		expression e = self;
+
+		e._expr = e._expr.place_last(other);
+
+		return e;
+	}
+
+	let _shift_last_(const expression& self) {
+
+		if (self._expr.size() == 0) {
+			return nothing();
+		}
+
+		expression e = self;
+
+		e._expr = e._expr.shift_last();
+
+		return e;
+	}
+
 	let _reverse_(const expression& self) {
 
 		if (self._expr.size() < 2) {
@@ -652,28 +726,37 @@ namespace Olly {
 
 	class statement {
 
-		let        _expr;
+		_vector_   _expr;
 
 	public:
 
 		statement();
 		statement(const statement& exp);
+		statement(statement&& exp) noexcept;
 		statement(let x);
 		statement(let x, let y);
+		statement(const std::vector<let>& items);
+		statement(const _vector_& items);
 		virtual ~statement();
 
 		friend str_type           _type_(const statement& self);
+		friend TYPE_KIND          _kind_(const statement& self);
 		friend bool_type            _is_(const statement& self);
 		friend real_type          _comp_(const statement& self, const let& other);
+		friend std::size_t        _hash_(const statement& self);
 
-		friend void                _str_(stream_type& out, const statement& self);
-		friend void               _repr_(stream_type& out, const statement& self);
+		friend void                _str_(output_sink& out, const statement& self);
+		friend void               _repr_(output_sink& out, const statement& self);
+		friend void             _encode_(encoder& out, const statement& self);
+		friend let            copy_value(const let& value, const let_allocator* from);
 
 		friend size_type          _size_(const statement& self);
 		friend let                _lead_(const statement& self);
 		friend let                _last_(const statement& self);
 		friend let          _place_lead_(const statement& self, const let& other);
 		friend let          _shift_lead_(const statement& self);
+		friend let          _place_last_(const statement& self, const let& other);
+		friend let          _shift_last_(const statement& self);
 		friend let             _reverse_(const statement& self);
 	};
 
@@ -683,16 +766,27 @@ namespace Olly {
 	//
 	/********************************************************************************************/
 
-	statement::statement() : _expr(_node_expr_()) {
+	statement::statement() : _expr() {
 	}
 
 	statement::statement(const statement& exp) : _expr(exp._expr){
 	}
 
-	statement::statement(let x) : _expr(_node_expr_(x)) {
+	statement::statement(statement&& exp) noexcept : _expr(std::move(exp._expr)) {
+	}
+
+	statement::statement(let x) : _expr() {
+		_expr = _expr.place_last(std::move(x));
+	}
+
+	statement::statement(let x, let y) : _expr() {
+		_expr = _expr.place_last(std::move(x)).place_last(std::move(y));
 	}
 
-	statement::statement(let x, let y) : _expr(_node_expr_(x, y)) {
+	statement::statement(const std::vector<let>& items) : _expr(items) {
+	}
+
+	statement::statement(const _vector_& items) : _expr(items) {
 	}
 
 	statement::~statement() {
@@ -702,6 +796,10 @@ namespace Olly {
 		return "statement";
 	}
 
+	TYPE_KIND _kind_(const statement& self) {
+		return TYPE_KIND::STATEMENT_TYPE;
+	}
+
 	bool_type _is_(const statement& self) {
 
 		return self._expr.is();
@@ -709,10 +807,20 @@ namespace Olly {
 
 	real_type _comp_(const statement& self, const let& other) {
 
-		return self._expr.comp(other);
+		const statement* e = other.cast<statement>();
+
+		if (e) {
+			return self._expr.comp(e->_expr);
+		}
+
+		return NOT_A_NUMBER;
+	}
+
+	std::size_t _hash_(const statement& self) {
+		return hash_combine(static_cast<std::size_t>(TYPE_KIND::STATEMENT_TYPE), self._expr.hash());
 	}
 
-	void _str_(stream_type& out, const statement& self) {
+	void _str_(output_sink& out, const statement& self) {
 
 		if (!_is_(self)) {
 			out << ":;";
@@ -726,7 +834,7 @@ namespace Olly {
 		out << ";";
 	}
 
-	void _repr_(stream_type& out, const statement& self) {
+	void _repr_(output_sink& out, const statement& self) {
 
 		if (!_is_(self)) {
 			out << ":;";
@@ -740,6 +848,11 @@ namespace Olly {
 		out << ";";
 	}
 
+	void _encode_(encoder& out, const statement& self) {
+		out.write_kind(TYPE_KIND::STATEMENT_TYPE);
+		self._expr.encode(out);
+	}
+
 	size_type _size_(const statement& self) {
 
 		return self._expr.size();
@@ -781,6 +894,32 @@ namespace Olly {
 		return e;
 	}
 
+	let _place_last_(const statement& self, const let& other) {
+
+		if (other.is_nothing()) {
+			return self;
+		}
+
+		statement e = self;
+
+		e._expr = e._expr.place_last(other);
+
+		return e;
+	}
+
+	let _shift_last_(const statement& self) {
+
+		if (self._expr.size() == 0) {
+			return nothing();
+		}
+
+		statement e = self;
+
+		e._expr = e._expr.shift_last();
+
+		return e;
+	}
+
 	let _reverse_(const statement& self) {
 
 		if (self._expr.size() < 2) {
@@ -21,8 +21,9 @@
 //			
 /********************************************************************************************/
 
-#include <map>
 #include "expression.h"
+#include "symbol.h"
+#include ".\support\scope.h"
 
 namespace Olly {
 
@@ -37,37 +38,41 @@ namespace Olly {
 	//
 	/********************************************************************************************/
 
-	typedef     std::map<str_type, let>    map_type;
-
 	class lambda {
 
 		let    _args;
 		let    _body;
 
-		map_type  _variables;
+		enclosure_type  _enclosure;    // The captured variables, shared by every copy.
 
 	public:
 
 		lambda();
 		lambda(const lambda& exp);
+		lambda(lambda&& exp) noexcept;
 		lambda(let exp);
 		lambda(let args, let body);
+		lambda(let args, let body, const enclosure_type& enclosure);
 		virtual ~lambda();
 
 		friend str_type           _type_(const lambda& self);
+		friend TYPE_KIND          _kind_(const lambda& self);
 		friend bool_type            _is_(const lambda& self);
 		friend real_type          _comp_(const lambda& self, const let& other);
-		friend void                _str_(stream_type& out, const lambda& self);
-		friend void               _repr_(stream_type& out, const lambda& self);
+		friend std::size_t        _hash_(const lambda& self);
+		friend void                _str_(output_sink& out, const lambda& self);
+		friend void               _repr_(output_sink& out, const lambda& self);
+		friend void             _encode_(encoder& out, const lambda& self);
+		friend let            copy_value(const let& value, const let_allocator* from);
 
 		friend size_type          _size_(const lambda& self);
 		friend let                _lead_(const lambda& self);
 		friend let                _last_(const lambda& self);
 
-		void bind_scope(const map_type& scope);
+		void bind_scope(const scope& frame);
 		void bind_variable(let var, let val);
 
-		map_type variables() const;
+		const enclosure_type& enclosure() const;
 
 		void print_enclosure() const;
 	};
@@ -78,24 +83,30 @@ namespace Olly {
 	//
 	/********************************************************************************************/
 
-	lambda::lambda() : _args(expression()), _body(expression()), _variables() {
+	lambda::lambda() : _args(expression()), _body(expression()), _enclosure() {
+	}
+
+	lambda::lambda(const lambda& exp) : _args(exp._args), _body(exp._body), _enclosure(exp._enclosure) {
 	}
 
-	lambda::lambda(const lambda& exp) : _args(exp._args), _body(exp._body), _variables(exp._variables) {
+	lambda::lambda(lambda&& exp) noexcept : _args(std::move(exp._args)), _body(std::move(exp._body)), _enclosure(std::move(exp._enclosure)) {
 	}
 
-	lambda::lambda(let exp) : _args(), _body(), _variables() {
+	lambda::lambda(let exp) : _args(), _body(), _enclosure() {
 
 		const lambda* l = exp.cast<lambda>();
 
 		if (l) {
 			_args      = l->_args;
 			_body      = l->_body;
-			_variables = l->_variables;
+			_enclosure = l->_enclosure;
 		}
 	}
 
-	lambda::lambda(let args, let body) : _args(args), _body(body), _variables() {
+	lambda::lambda(let args, let body) : _args(args), _body(body), _enclosure() {
+	}
+
+	lambda::lambda(let args, let body, const enclosure_type& enclosure) : _args(args), _body(body), _enclosure(enclosure) {
 	}
 
 	lambda::~lambda() {
@@ -105,6 +116,10 @@ namespace Olly {
 		return "lambda";
 	}
 
+	TYPE_KIND _kind_(const lambda& self) {
+		return TYPE_KIND::LAMBDA_TYPE;
+	}
+
 	bool_type _is_(const lambda& self) {
 
 		if (self._args.is() || self._body.is()) {
@@ -128,7 +143,14 @@ namespace Olly {
 		return NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const lambda& self) {
+	std::size_t _hash_(const lambda& self) {
+
+		std::size_t hash = hash_combine(static_cast<std::size_t>(TYPE_KIND::LAMBDA_TYPE), self._args.hash());
+
+		return hash_combine(hash, self._body.hash());
+	}
+
+	void _str_(output_sink& out, const lambda& self) {
 
 		if (!_is_(self)) {
 			out << "lambda():;";
@@ -137,20 +159,20 @@ namespace Olly {
 
 		out << "lambda";
 
-		out << str(self._args);
+		str(out, self._args);
 
 		out << ":";
 
 		let body = self._body;
 
 		while (body.is()) {
-			out << str(pop_lead(body));
+			str(out, pop_lead(body));
 		}
 
 		out << ";";
 	}
 
-	void _repr_(stream_type& out, const lambda& self) {
+	void _repr_(output_sink& out, const lambda& self) {
 
 		if (!_is_(self)) {
 			out << "lambda():;";
@@ -159,19 +181,41 @@ namespace Olly {
 
 		out << "lambda";
 
-		out << repr(self._args);
+		self._args.repr(out);
 
 		out << ": ";
 
 		let body = self._body;
 
 		while (body.is()) {
-			out << repr(pop_lead(body)) << " ";
+			pop_lead(body).repr(out);
+			out << " ";
 		}
 
 		out << ";";
 	}
 
+	void _encode_(encoder& out, const lambda& self) {
+		/*
+			Write the arguments and body, followed by the name
+			and value of each captured variable.
+		*/
+
+		out.write_kind(TYPE_KIND::LAMBDA_TYPE);
+
+		self._args.encode(out);
+		self._body.encode(out);
+
+		scope vars = self._enclosure ? self._enclosure->capture(scope::npos) : scope();
+
+		out.write_size(vars.size());
+
+		for (size_type i = 0, stop = vars.size(); i < stop; i += 1) {
+			out.write_text(symbol_text(vars.id(i)));
+			vars.get(i).encode(out);
+		}
+	}
+
 	size_type _size_(const lambda& self) {
 		return self._args.size();
 	}
@@ -194,33 +238,49 @@ namespace Olly {
 		return self._body;
 	}
 
-	inline void Olly::lambda::bind_scope(const map_type& scope) {
+	inline void Olly::lambda::bind_scope(const scope& frame) {
+		/*
+			Capture a flat copy of the frame, less the lambda it belongs to.
+			The enclosure is rebuilt rather than changed, since other copies
+			of this lambda may share it.
+		*/
 		
-		auto name_loc = scope.find("self");
+		size_type name_loc = frame.find(intern_symbol("self"));
 
-		auto name = (name_loc == scope.cend()) ? "" : str(name_loc->second);
+		size_type name = (name_loc == scope::npos) ? scope::npos : symbol_id(frame.get(name_loc));
 
-		for (auto itr : scope) {
-			
-			if (itr.first != name) {
+		scope vars = _enclosure ? _enclosure->capture(scope::npos) : scope();
 
-				_variables[itr.first] = itr.second;
-			}
+		scope captured = frame.capture(name);
+
+		for (size_type i = 0, stop = captured.size(); i < stop; i += 1) {
+			vars.set(captured.id(i), captured.get(i));
 		}
+
+		_enclosure = std::make_shared<const scope>(std::move(vars));
 	}
 
 	inline void lambda::bind_variable(let var, let val) {
-		_variables[str(var)] = val;
+
+		scope vars = _enclosure ? _enclosure->capture(scope::npos) : scope();
+
+		vars.set(symbol_id(var), val);
+
+		_enclosure = std::make_shared<const scope>(std::move(vars));
 	}
 
-	inline map_type Olly::lambda::variables() const {
-		return _variables;
+	inline const enclosure_type& Olly::lambda::enclosure() const {
+		return _enclosure;
 	}
 
 	inline void Olly::lambda::print_enclosure() const {
 
-		for (auto itr : _variables) {
-			std::cout << itr.first << " = " << str(itr.second) << std::endl;
+		if (!_enclosure) {
+			return;
+		}
+
+		for (size_type i = 0, stop = _enclosure->size(); i < stop; i += 1) {
+			std::cout << symbol_text(_enclosure->id(i)) << " = " << str(_enclosure->get(i)) << std::endl;
 		}
 	}
 }
\ No newline at end of file
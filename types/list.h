@@ -32,9 +32,10 @@ namespace Olly {
 	//
 	//                              'list' Class Definition
 	//
-	//          The list class is a doubled ended queue.  It is implimented
-	//          using two expression data types representing the front and back
-	//          portions of the queue.  
+	//          The list class is an indexed sequence.  It is implimented using the
+	//          persistent _vector_, so elements may be read by their index and single
+	//          elements replaced, without copying the rest of the list.  Elements are
+	//          indexed in logarithmic time whichever end they were placed at.
 	//
 	/********************************************************************************************/
 
@@ -42,18 +43,25 @@ namespace Olly {
 
 	public:
 
-		typedef     std::vector<let>	  list_type;
+		typedef     _vector_	  list_type;
 
 		list();
 		list(const list& exp);
+		list(list&& exp) noexcept;
 		list(let exp);
+		list(const std::vector<let>& items);
+		list(const list_type& items);
 		virtual ~list();
 
 		friend str_type           _type_(const list& self);
+		friend TYPE_KIND          _kind_(const list& self);
 		friend bool_type            _is_(const list& self);
 		friend real_type          _comp_(const list& self, const let& other);
-		friend void                _str_(stream_type& out, const list& self);
-		friend void               _repr_(stream_type& out, const list& self);
+		friend std::size_t        _hash_(const list& self);
+		friend void                _str_(output_sink& out, const list& self);
+		friend void               _repr_(output_sink& out, const list& self);
+		friend void             _encode_(encoder& out, const list& self);
+		friend let            copy_value(const let& value, const let_allocator* from);
 
 		friend size_type          _size_(const list& self);
 		friend let                _lead_(const list& self);
@@ -72,10 +80,10 @@ namespace Olly {
 
 		const list_type& get_list() const;
 
-		let begin();
-
 	private:
 		list_type    _list;
+
+		bool_type    position(const let& key, size_type& i)  const;  // The zero based position of a one based index.
 	};
 
 	/********************************************************************************************/
@@ -90,14 +98,25 @@ namespace Olly {
 	list::list(const list& exp) : _list(exp._list) {
 	}
 
+	list::list(list&& exp) noexcept : _list(std::move(exp._list)) {
+	}
+
 	list::list(let exp) : _list() {
-		
-		_list.reserve(exp.size());
+
+		_vector_builder_ items;
 
 		while (exp.is()) {
 
-			_list.emplace_back(pop_lead(exp));
+			items.place_last(pop_lead(exp));
 		}
+
+		_list = items.persistent();
+	}
+
+	list::list(const std::vector<let>& items) : _list(items) {
+	}
+
+	list::list(const list_type& items) : _list(items) {
 	}
 
 	list::~list() {
@@ -107,13 +126,12 @@ namespace Olly {
 		return "list";
 	}
 
-	bool_type _is_(const list& self) {
-
-		if (_size_(self) > 0) {
-			return true;
-		}
+	TYPE_KIND _kind_(const list& self) {
+		return TYPE_KIND::LIST_TYPE;
+	}
 
-		return false;
+	bool_type _is_(const list& self) {
+		return self._list.is();
 	}
 
 	real_type _comp_(const list& self, const let& other) {
@@ -121,75 +139,49 @@ namespace Olly {
 		const list* e = other.cast<list>();
 
 		if (e) {
-
-			if (self._list == e->_list) {
-				return 0.0;
-			}
+			return self._list.comp(e->_list);
 		}
 
 		return NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const list& self) {
+	std::size_t _hash_(const list& self) {
+		return hash_combine(static_cast<std::size_t>(TYPE_KIND::LIST_TYPE), self._list.hash());
+	}
 
-		if (self._list.empty()) {
-			out << "[]";
-			return;
-		}
+	void _str_(output_sink& out, const list& self) {
 
 		out << "[";
 
-		for (auto i = self._list.cbegin(); i != self._list.cend(); ++i) {
-
-			i->str(out);
-			out << " ";
-		}
-
-		out.seekp(-1, out.cur);
+		self._list.str(out);
 
 		out << "]";
 	}
 
-	void _repr_(stream_type& out, const list& self) {
-
-		if (self._list.empty()) {
-			out << "[]";
-			return;
-		}
+	void _repr_(output_sink& out, const list& self) {
 
 		out << "[";
 
-		for (auto i = self._list.cbegin(); i != self._list.cend(); ++i) {
-
-			i->repr(out);
-			out << " ";
-		}
-
-		out.seekp(-1, out.cur);
+		self._list.repr(out);
 
 		out << "]";
 	}
 
+	void _encode_(encoder& out, const list& self) {
+		out.write_kind(TYPE_KIND::LIST_TYPE);
+		self._list.encode(out);
+	}
+
 	size_type _size_(const list& self) {
 		return self._list.size();
 	}
 
 	let _lead_(const list& self) {
-
-		if (self._list.empty()) {
-			return nothing();
-		}
-
-		return self._list.front();
+		return self._list.lead();
 	}
 
 	let _last_(const list& self) {
-
-		if (self._list.empty()) {
-			return nothing();
-		}
-
-		return self._list.back();
+		return self._list.last();
 	}
 
 	let _place_lead_(const list& self, const let& other) {
@@ -198,11 +190,7 @@ namespace Olly {
 			return self;
 		}
 
-		list e = self;
-
-		e._list.emplace(e._list.begin(), other);
-
-		return e;
+		return list(self._list.place_lead(other));
 	}
 
 	let _shift_lead_(const list& self) {
@@ -211,11 +199,7 @@ namespace Olly {
 			return self;
 		}
 
-		list e = self;
-
-		e._list.erase(e._list.begin());
-
-		return e;
+		return list(self._list.shift_lead());
 	}
 
 	let _place_last_(const list& self, const let& other) {
@@ -224,11 +208,7 @@ namespace Olly {
 			return self;
 		}
 
-		list e = self;
-
-		e._list.emplace_back(other);
-
-		return e;
+		return list(self._list.place_last(other));
 	}
 
 	let _shift_last_(const list& self) {
@@ -237,11 +217,7 @@ namespace Olly {
 			return self;
 		}
 
-		list e = self;
-
-		e._list.pop_back();
-
-		return e;
+		return list(self._list.shift_last());
 	}
 
 	let _reverse_(const list& self) {
@@ -250,81 +226,33 @@ namespace Olly {
 			return self;
 		}
 
-		list e;
-
-		std::reverse(e._list.begin(), e._list.end());
-
-		return e;
+		return list(self._list.reverse());
 	}
 
 	let _get_(const list& self, const let& key) {
 
-		const number* n = key.cast<number>();
-
-		if (n) {
-
-			auto i = n->integer();
+		size_type i;
 
-			if (i == 0 || std::abs(i) > _size_(self)) {
-				return nothing();
-			}
-
-			list l = self;
-
-			bool_type rev = i < 0 ? true : false;
-
-			if (rev) {
-				int_type len = static_cast<int_type>(l._list.size());
-				i = len + i;
-			}
-			else {
-				i -= 1;
-			}
-
-			return l._list[i];
+		if (self.position(key, i)) {
+			return self._list.at(i);
 		}
 
-
 		return nothing();
 	}
 
 	let _set_(const list& self, const let& key, const let& val) {
 
-		const number* n = key.cast<number>();
-
-		if (n) {
-
-			auto i = n->integer();
-
-			if (i == 0 || std::abs(i) > _size_(self)) {
-				return nothing();
-			}
+		size_type i;
 
-			list l = self;
+		if (self.position(key, i)) {
 
-			bool_type rev = i < 0 ? true : false;
-
-			if (rev) {
-				int_type len = static_cast<int_type>(l._list.size());
-				i = len + i;
-			}
-			else {
-				i -= 1;
-			}
-
-			l._list[i] = val;
-
-			return l;
+			return list(self._list.set(i, val));
 		}
 
-
 		return nothing();
 	}
 
 	let _itr_(const list& self) { 
-
-		auto i = self._list.begin();
-
 		return nothing();
 	}
 
@@ -335,4 +263,28 @@ namespace Olly {
 	inline const Olly::list::list_type& Olly::list::get_list() const {
 		return _list;
 	}
+
+	bool_type list::position(const let& key, size_type& i) const {
+		/*
+			Indexes count from one at the lead of the list, and
+			negative indexes count back from the last element.
+		*/
+
+		const number* n = key.cast<number>();
+
+		if (!n) {
+			return false;
+		}
+
+		int_type index = n->integer();
+		int_type len   = static_cast<int_type>(_list.size());
+
+		if (index == 0 || std::abs(index) > len) {
+			return false;
+		}
+
+		i = static_cast<size_type>(index < 0 ? len + index : index - 1);
+
+		return true;
+	}
 }
\ No newline at end of file
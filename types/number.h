@@ -57,15 +57,18 @@ namespace Olly {
 		number(const unsigned long long& value);
 		number(const unsigned long& value);
 		number(const unsigned int& value);
-		virtual ~number();
+		~number();
 
 		friend stream_type& operator >> (stream_type& stream, number& self);
 
 		friend str_type      _type_(const number& self);
+		friend TYPE_KIND     _kind_(const number& self);
 		friend bool_type       _is_(const number& self);
 		friend real_type     _comp_(const number& self, const let& other);
-		friend void        _str_(stream_type& out, const number& self);
-		friend void       _repr_(stream_type& out, const number& self);
+		friend std::size_t   _hash_(const number& self);
+		friend void        _str_(output_sink& out, const number& self);
+		friend void       _repr_(output_sink& out, const number& self);
+		friend void     _encode_(encoder& out, const number& self);
 
 		friend let         _add_(const number& self, const let& other);
 		friend let         _sub_(const number& self, const let& other);
@@ -89,6 +92,13 @@ namespace Olly {
 		num_t _value;
 	};
 
+	template <>
+	struct inline_storage<number> {
+		static const bool_type value = true;
+	};
+
+	static_assert(let::is_inline<number>(), "A number must fit within let::INLINE_SIZE.");
+
 	number::number() : _value(0.0, 0.0) {
 	}
 
@@ -181,6 +191,10 @@ namespace Olly {
 		return "number";
 	}
 
+	TYPE_KIND _kind_(const number& self) {
+		return TYPE_KIND::NUMBER_TYPE;
+	}
+
 	bool_type _is_(const number& self) {
 
 		if (_nan_(self)) {
@@ -216,7 +230,18 @@ namespace Olly {
 		return NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const number& self) {
+	std::size_t _hash_(const number& self) {
+		/*
+			Hash the bits of each part of the number, so
+			equal numbers share a hash.
+		*/
+
+		std::size_t hash = hash_combine(static_cast<std::size_t>(TYPE_KIND::NUMBER_TYPE), hash_real(self._value.real()));
+
+		return hash_combine(hash, hash_real(self._value.imag()));
+	}
+
+	void _str_(output_sink& out, const number& self) {
 
 		real_type real = self._value.real();
 		real_type imag = self._value.imag();
@@ -241,19 +266,25 @@ namespace Olly {
 
 		out << "(" << real << ",";
 
-		out.setf(std::ios::showpos);
+		out.show_sign(true);
 
 		out << imag << "j)";
 
-		out.unsetf(std::ios::showpos);
+		out.show_sign(false);
 	}
 
-	void _repr_(stream_type& out, const number& self) {
+	void _repr_(output_sink& out, const number& self) {
 		out << "\'";
 		_str_(out, self);
 		out << "\'";
 	}
 
+	void _encode_(encoder& out, const number& self) {
+		out.write_kind(TYPE_KIND::NUMBER_TYPE);
+		out.write_real(self._value.real());
+		out.write_real(self._value.imag());
+	}
+
 	let _add_(const number& self, const let& other) {
 
 		const number* n = other.cast<number>();
@@ -5,23 +5,24 @@
 //			Copyright 2019 Max J. Martin
 //
 //			This file is part of Oliver.
-//			
+//
 //			Oliver is free software : you can redistribute it and / or modify
 //			it under the terms of the GNU General Public License as published by
 //			the Free Software Foundation, either version 3 of the License, or
 //			(at your option) any later version.
-//			
+//
 //			Oliver is distributed in the hope that it will be useful,
 //			but WITHOUT ANY WARRANTY; without even the implied warranty of
 //			MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
 //			GNU General Public License for more details.
-//			
+//
 //			You should have received a copy of the GNU General Public License
 //			along with Oliver.If not, see < https://www.gnu.org/licenses/>.
-//			
+//
 /********************************************************************************************/
 
 #include "expression.h"
+#include "support\hash_map.h"
 
 namespace Olly {
 
@@ -29,234 +30,271 @@ namespace Olly {
 	//
 	//                              'set' Class Definition
 	//
-	//          The set class is a doubled ended queue.  It is implimented
-	//          using two expression data types representing the front and back
-	//          portions of the queue.  
+	//          The set class maps keys to values, held within a persistent hash
+	//          array mapped trie.  A key given without a value is held as a member
+	//          of the set, mapped to nothing.  The key 'name' is reserved, and gives
+	//          the type name of the set.
+	//
+	//              Example:  {name = "point" x = '1' y = '2'}
 	//
 	/********************************************************************************************/
 
 	class set {
 
-		let    _set;
-		str_type  _name;
+		_hash_map_   _map;
+		str_type    _name;
 
 	public:
 
 		set();
 		set(const set& exp);
+		set(set&& exp) noexcept;
 		set(let exp);
-		set(let x, let y);
+		set(const _hash_map_& entries);
 		virtual ~set();
 
 		friend str_type           _type_(const set& self);
+		friend TYPE_KIND          _kind_(const set& self);
 		friend bool_type            _is_(const set& self);
 		friend real_type          _comp_(const set& self, const let& other);
-		friend void             _str_(stream_type& out, const set& self);
-		friend void            _repr_(stream_type& out, const set& self);
+		friend std::size_t        _hash_(const set& self);
 
-		friend int_type            _len_(const set& self);
-		friend let              _get_(const set& self, const let& key);
-		friend let              data_t_set_(const set& self, const let& key, const let& val);
+		friend void                _str_(output_sink& out, const set& self);
+		friend void               _repr_(output_sink& out, const set& self);
+		friend void             _encode_(encoder& out, const set& self);
+		friend let            copy_value(const let& value, const let_allocator* from);
+
+		friend size_type          _size_(const set& self);
+		friend let                 _get_(const set& self, const let& key);
+		friend let                 _set_(const set& self, const let& key, const let& val);
+
+		friend bool_type        _is_set_(const set& self);
+
+		void bind_name(const str_type& name);
+		void bind_variable(let var, let val);
+
+	private:
+		static bool_type is_name(const let& var);                             // Is the key the reserved 'name'.
 	};
 
+	static const str_type DEFAULT_SET_NAME("set");
+
 	/********************************************************************************************/
 	//
 	//                               'set' Class Implimentation
 	//
 	/********************************************************************************************/
 
-	set::set() : _set(expression()), _name("\"set\"") {
+	set::set() : _map(), _name(DEFAULT_SET_NAME) {
 	}
 
-	set::set(const set& obj) : _set(obj._set), _name(obj._name) {
+	set::set(const set& obj) : _map(obj._map), _name(obj._name) {
 	}
 
-	set::set(let exp) : _set(expression()), _name("\"set\"") {
+	set::set(set&& obj) noexcept : _map(std::move(obj._map)), _name(std::move(obj._name)) {
+	}
+
+	set::set(let exp) : _map(), _name(DEFAULT_SET_NAME) {
+		/*
+			Build the set from an expression of keys, each
+			optionally followed by '=' and its value.
+		*/
+
+		_hash_map_builder_ entries;
 
 		while (exp.is()) {
 
 			let var = pop_lead(exp);
-			let val = pop_lead(exp);
+			let val = nothing();
 
-			if (val.type() == "op_call" && val.op_code() == OP_CODE::NOTHING_OP) {
-				val = pop_lead(exp);
+			if (exp.lead().op_code() == OP_CODE::eq_op) {
 
-				if (to_upper(str(var)) == "NAME") {
-					_name = repr(val);
-				}
-				else {
-					let pair = expression(var, val);
+				exp = exp.shift_lead();
+				val = pop_lead(exp);
+			}
 
-					_set = _set.place_last(pair);
-				}
+			if (is_name(var)) {
+				_name = str(val);
 			}
 			else {
-				exp = exp.place_lead(val);
-				_set = _set.place_last(expression(var));
+				entries.set(var, val);
 			}
 		}
+
+		_map = entries.persistent();
 	}
 
-	set::set(let x, let y) : _set(expression(x, y)), _name("\"set\"") {
+	set::set(const _hash_map_& entries) : _map(entries), _name(DEFAULT_SET_NAME) {
 	}
 
 	set::~set() {
 	}
 
+	void set::bind_name(const str_type& name) {
+		_name = name;
+	}
+
+	void set::bind_variable(let var, let val) {
+
+		if (is_name(var)) {
+			_name = str(val);
+			return;
+		}
+
+		_map = _map.set(var, val);
+	}
+
+	bool_type set::is_name(const let& var) {
+		return var.kind() == TYPE_KIND::SYMBOL_TYPE && to_upper(str(var)) == "NAME";
+	}
+
 	std::string _type_(const set& self) {
 		return self._name;
 	}
 
+	TYPE_KIND _kind_(const set& self) {
+		return TYPE_KIND::SET_TYPE;
+	}
+
 	bool_type _is_(const set& self) {
-		return self._set.is();
+		return self._map.is();
 	}
 
 	real_type _comp_(const set& self, const let& other) {
 
 		const set* e = other.cast<set>();
 
-		if (e) {
-
-			if (self._name == e->_name) {
-
-				if (self._set == e->_set) {
-					return 0.0;
-				}
-			}
+		if (e && self._name == e->_name) {
+			return self._map.comp(e->_map);
 		}
 
 		return NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const set& self) {
+	std::size_t _hash_(const set& self) {
 
-		out << "{";
+		std::size_t hash = hash_combine(static_cast<std::size_t>(TYPE_KIND::SET_TYPE), DEFAULT_HASH_FUNCTION(self._name));
 
-		let exp = self._set;
-		int_type limit = self._set.len();
+		return hash_combine(hash, self._map.hash());
+	}
 
-		if (limit) {
-			limit -= 1;
-		}
+	void _str_(output_sink& out, const set& self) {
+
+		std::vector<let> keys;
+		std::vector<let> values;
+
+		self._map.items(keys, values);
+
+		out << "{";
+
+		if (self._name != DEFAULT_SET_NAME) {
 
-		if (self._name != "\"set\"") {
 			out << self._name;
 
-			if (limit) {
+			if (!keys.empty()) {
 				out << " ";
 			}
 		}
 
-		while (exp.is()) {
-
-			let pair = pop_lead(exp);
+		for (size_type i = 0, stop = keys.size(); i < stop; i += 1) {
 
-			if (pair.len() > 1) {
-				out << str(pair.lead()) << "=" << str(pair.last());
-			}
-			else {
-				out << str(pair.lead());
+			if (i) {
+				out << " ";
 			}
 
-			if (limit) {
-				limit -= 1;
-				out << " ";
+			str(out, keys[i]);
+
+			if (!values[i].is_nothing()) {
+				out << "=";
+				str(out, values[i]);
 			}
 		}
 
 		out << "}";
 	}
 
-	void _repr_(stream_type& out, const set& self) {
+	void _repr_(output_sink& out, const set& self) {
 
-		out << "{";
+		std::vector<let> keys;
+		std::vector<let> values;
 
-		let exp = self._set;
-		int_type limit = self._set.len();
+		self._map.items(keys, values);
 
-		if (limit) {
-			limit -= 1;
-		}
+		out << "{";
+
+		if (self._name != DEFAULT_SET_NAME) {
 
-		if (self._name != "set") {
-			out << "name=" << self._name;
+			out << "name = \"" << self._name << "\"";
 
-			if (limit) {
+			if (!keys.empty()) {
 				out << " ";
 			}
 		}
 
-		while (exp.is()) {
+		for (size_type i = 0, stop = keys.size(); i < stop; i += 1) {
 
-			let pair = pop_lead(exp);
-
-			if (pair.len() > 1) {
-				out << repr(first(pair)) << "=" << repr(second(pair));
-			}
-			else {
-				out << repr(pair.lead());
+			if (i) {
+				out << " ";
 			}
 
-			if (limit) {
-				limit -= 1;
-				out << " ";
+			keys[i].repr(out);
+
+			if (!values[i].is_nothing()) {
+				out << " = ";
+				values[i].repr(out);
 			}
 		}
 
 		out << "}";
 	}
 
-	int_type _len_(const set& self) {
+	void _encode_(encoder& out, const set& self) {
+		/*
+			Write the name and the number of entries, then
+			each key followed by its value.
+		*/
 
-		return self._set.len();
-	}
-
-	let _get_(const set& self, const let& key) {
+		std::vector<let> keys;
+		std::vector<let> values;
 
-		let exp = self;
-
-		while (exp.is()) {
+		self._map.items(keys, values);
 
-			let pair = pop_lead(exp);
+		out.write_kind(TYPE_KIND::SET_TYPE);
+		out.write_text(self._name);
+		out.write_size(keys.size());
 
-			if (first(pair) == key) {
-				return second(pair);
-			}
+		for (size_type i = 0, stop = keys.size(); i < stop; i += 1) {
+			keys[i].encode(out);
+			values[i].encode(out);
 		}
+	}
 
-		return nothing();
+	size_type _size_(const set& self) {
+		return self._map.size();
 	}
 
-	let data_t_set_(const set& self, const let& key, const let& val) {
+	let _get_(const set& self, const let& key) {
 
-		set new_set;
+		const let* val = self._map.find(key);
 
-		if (to_upper(str(key)) == "NAME") {
-			new_set._name = repr(val.lead());
-			return new_set;
+		if (val) {
+			return *val;
 		}
 
-		let exp = self._set;
-		bool_type set = false;
+		return nothing();
+	}
 
-		while (exp.is()) {
+	let _set_(const set& self, const let& key, const let& val) {
 
-			let pair = pop_lead(exp);
+		set s = self;
 
-			if (not set && first(pair) == key) {
-				set = true;
-				pair = expression(first(pair), val);
-			}
+		s.bind_variable(key, val);
 
-			new_set._set = new_set._set.place_last(pair);
-		}
-
-		if (not set) {
-
-			new_set._set = new_set._set.place_last(expression(key, val));
-		}
+		return s;
+	}
 
-		return new_set;
+	bool_type _is_set_(const set& self) {
+		return true;
 	}
 
-}
\ No newline at end of file
+}
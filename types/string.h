@@ -44,6 +44,7 @@ namespace Olly {
 
 		string();
 		string(const string& obj);
+		string(string&& obj) noexcept;
 		string(str_type str);
 		string(const char& c);
 		virtual ~string();
@@ -51,10 +52,14 @@ namespace Olly {
 		friend  stream_type& operator >> (stream_type& stream, string& self);
 
 		friend str_type       _type_(const string& self);
+		friend TYPE_KIND      _kind_(const string& self);
 		friend bool          _is_(const string& self);
 		friend real_type      _comp_(const string& self, const let& other);
-		friend void         _str_(stream_type& out, const string& self);
-		friend void        _repr_(stream_type& out, const string& self);
+		friend std::size_t    _hash_(const string& self);
+		friend void         _str_(output_sink& out, const string& self);
+		friend void        _repr_(output_sink& out, const string& self);
+		friend void      _encode_(encoder& out, const string& self);
+		friend let     copy_value(const let& value, const let_allocator* from);
 
 		friend int_type        _len_(const string& self);
 		friend let         _lead_(const string& self);
@@ -72,6 +77,9 @@ namespace Olly {
 	string::string(const string& obj) : _value(obj._value) {
 	}
 
+	string::string(string&& obj) noexcept : _value(std::move(obj._value)) {
+	}
+
 	string::string(str_type str) : _value(str) {
 	}
 
@@ -83,7 +91,7 @@ namespace Olly {
 
 	stream_type& operator >> (stream_type& stream, string& self) {
 
-		self = string(stream.str());
+		self._value = stream.str();
 
 		return stream;
 	}
@@ -92,6 +100,10 @@ namespace Olly {
 		return "string";
 	}
 
+	TYPE_KIND _kind_(const string& self) {
+		return TYPE_KIND::STRING_TYPE;
+	}
+
 	bool _is_(const string& self) {
 		return !self._value.empty();
 	}
@@ -115,16 +127,25 @@ namespace Olly {
 		return NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const string& self) {
+	std::size_t _hash_(const string& self) {
+		return hash_combine(static_cast<std::size_t>(TYPE_KIND::STRING_TYPE), DEFAULT_HASH_FUNCTION(self._value));
+	}
+
+	void _str_(output_sink& out, const string& self) {
 		out << self._value;
 	}
 
-	void _repr_(stream_type& out, const string& self) {
+	void _repr_(output_sink& out, const string& self) {
 		out << "\"";
 		_str_(out, self);
 		out << "\"";
 	}
 
+	void _encode_(encoder& out, const string& self) {
+		out.write_kind(TYPE_KIND::STRING_TYPE);
+		out.write_text(self._value);
+	}
+
 	int_type _len_(const string& self) {
 		return (int_type)self._value.size();
 	}
@@ -0,0 +1,434 @@
+#pragma once
+
+/********************************************************************************************/
+//
+//			Copyright 2019 Max J. Martin
+//
+//			This file is part of Oliver.
+//
+//			Oliver is free software : you can redistribute it and / or modify
+//			it under the terms of the GNU General Public License as published by
+//			the Free Software Foundation, either version 3 of the License, or
+//			(at your option) any later version.
+//
+//			Oliver is distributed in the hope that it will be useful,
+//			but WITHOUT ANY WARRANTY; without even the implied warranty of
+//			MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//			GNU General Public License for more details.
+//
+//			You should have received a copy of the GNU General Public License
+//			along with Oliver.If not, see < https://www.gnu.org/licenses/>.
+//
+/********************************************************************************************/
+
+#include <atomic>
+#include <bitset>
+#include <climits>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "..\..\let.h"
+
+namespace Olly {
+
+	/********************************************************************************************/
+	//
+	//                                '_hash_map_' Class Definition
+	//
+	//          The _hash_map_ class is a persistent map from keys to values, used to
+	//          back the set data type.  It is a hash array mapped trie, where each
+	//          level of the trie is indexed by the next five bits of the hash of a key.
+	//          A node only holds the positions in use, marked within a bitmap, so a
+	//          sparse node stays small.  Keys whose hashes are equal in every bit are
+	//          kept together in a bucket at the bottom of the trie.
+	//
+	//          Every modification returns a new _hash_map_, copying only the nodes on
+	//          the path to the changed key and sharing the rest with the original.
+	//          This gives logarithmic time get and set, to the base 32.
+	//
+	/********************************************************************************************/
+
+	class _hash_map_ {
+
+		static const size_type BITS      = 5;
+		static const size_type MASK      = (1 << BITS) - 1;
+		static const size_type HASH_BITS = sizeof(size_type) * CHAR_BIT;
+
+		struct _trie_;
+
+		typedef std::shared_ptr<const _trie_>    trie_ptr;
+
+		struct _entry_ {
+			size_type                   _hash;
+			let                          _key;
+			let                        _value;
+		};
+
+		struct _slot_ {
+			trie_ptr                   _child;    // A sub trie, else the slot holds a single entry.
+			_entry_                    _entry;
+		};
+
+		struct _trie_ {
+			size_type                                        _edit;    // The builder which may modify the node in place, else zero.
+			std::uint32_t                                  _bitmap;    // The positions of the node in use.
+			std::vector<_slot_, pool_allocator<_slot_>>     _slots;    // One slot for each position in use, in order, from the pool of the thread.
+			std::vector<_entry_, pool_allocator<_entry_>>  _bucket;    // The entries of keys with colliding hashes, from the pool.
+		};
+
+		trie_ptr     _root;
+		size_type    _count;
+		hash_cache   _hash;      // The hash of the entries, once computed.
+
+	public:
+
+		_hash_map_();
+
+		bool_type          is()                                        const;  // Does the map hold any entries.
+		size_type        size()                                        const;  // The number of entries.
+
+		const let*       find(const let& key)                          const;  // The value of a key, or null.
+		_hash_map_        set(const let& key, const let& val)          const;
+
+		void            items(std::vector<let>& keys, std::vector<let>& values)  const;  // Append each entry.
+
+		real_type        comp(const _hash_map_& other)                 const;  // 0.0 if each entry is equal, else NaN.
+		size_type        hash()                                        const;  // Combine the hash of each entry.
+
+	private:
+
+		static size_type  position(size_type hash, size_type shift);
+		static size_type     index(std::uint32_t bitmap, std::uint32_t bit);
+
+		static trie_ptr     assoc(const trie_ptr& node, size_type shift, const _entry_& entry, bool_type& added, size_type edit);
+		static void          walk(const trie_ptr& node, std::vector<let>& keys, std::vector<let>& values);
+
+		friend class _hash_map_builder_;
+	};
+
+	/********************************************************************************************/
+	//
+	//                            '_hash_map_builder_' Class Definition
+	//
+	//          The _hash_map_builder_ class is a transient, used to build a _hash_map_
+	//          one entry at a time.  Each node the builder creates is marked with its
+	//          edit id, and is modified in place by later entries rather than copied.
+	//          Taking the finished map gives the builder a new edit id, so the nodes
+	//          of the map are never modified again.
+	//
+	/********************************************************************************************/
+
+	class _hash_map_builder_ {
+
+		_hash_map_     _map;
+		size_type     _edit;
+
+	public:
+
+		_hash_map_builder_();
+
+		size_type        size()                                        const;
+
+		void              set(const let& key, const let& val);
+		_hash_map_ persistent();                                               // Take the map built.
+
+	private:
+		_hash_map_builder_(const _hash_map_builder_& obj) = delete;
+
+		static size_type next_edit();
+	};
+
+	/********************************************************************************************/
+	//
+	//                              '_hash_map_' Class Implimentation
+	//
+	/********************************************************************************************/
+
+	_hash_map_::_hash_map_() : _root(), _count(0), _hash() {
+	}
+
+	bool_type _hash_map_::is() const {
+		return _count > 0;
+	}
+
+	size_type _hash_map_::size() const {
+		return _count;
+	}
+
+	const let* _hash_map_::find(const let& key) const {
+
+		size_type hash  = key.hash();
+		size_type shift = 0;
+
+		const _trie_* node = _root.get();
+
+		while (node) {
+
+			if (shift >= HASH_BITS) {
+
+				for (const _entry_& entry : node->_bucket) {
+
+					if (entry._hash == hash && entry._key == key) {
+						return &entry._value;
+					}
+				}
+
+				return nullptr;
+			}
+
+			std::uint32_t bit = static_cast<std::uint32_t>(1) << position(hash, shift);
+
+			if (!(node->_bitmap & bit)) {
+				return nullptr;
+			}
+
+			const _slot_& slot = node->_slots[index(node->_bitmap, bit)];
+
+			if (!slot._child) {
+
+				if (slot._entry._hash == hash && slot._entry._key == key) {
+					return &slot._entry._value;
+				}
+
+				return nullptr;
+			}
+
+			node   = slot._child.get();
+			shift += BITS;
+		}
+
+		return nullptr;
+	}
+
+	_hash_map_ _hash_map_::set(const let& key, const let& val) const {
+
+		bool_type added = false;
+
+		_hash_map_ m = *this;
+
+		m._root = assoc(_root, 0, _entry_{ key.hash(), key, val }, added, 0);
+
+		if (added) {
+			m._count += 1;
+		}
+
+		return m;
+	}
+
+	void _hash_map_::items(std::vector<let>& keys, std::vector<let>& values) const {
+
+		keys.reserve(keys.size() + _count);
+		values.reserve(values.size() + _count);
+
+		walk(_root, keys, values);
+	}
+
+	real_type _hash_map_::comp(const _hash_map_& other) const {
+
+		if (_count != other._count) {
+			return NOT_A_NUMBER;
+		}
+
+		std::vector<let> keys;
+		std::vector<let> values;
+
+		items(keys, values);
+
+		for (size_type i = 0, stop = keys.size(); i < stop; i += 1) {
+
+			const let* val = other.find(keys[i]);
+
+			if (!val || *val != values[i]) {
+				return NOT_A_NUMBER;
+			}
+		}
+
+		return 0.0;
+	}
+
+	size_type _hash_map_::hash() const {
+		/*
+			The order of the entries depends upon the shape of the
+			trie, so the hash of each entry is summed, rather than
+			combined in turn.
+		*/
+
+		if (_hash.is()) {
+			return _hash.get();
+		}
+
+		std::vector<let> keys;
+		std::vector<let> values;
+
+		items(keys, values);
+
+		size_type hash = _count;
+
+		for (size_type i = 0, stop = keys.size(); i < stop; i += 1) {
+			hash += hash_combine(keys[i].hash(), values[i].hash());
+		}
+
+		return _hash.set(hash);
+	}
+
+	size_type _hash_map_::position(size_type hash, size_type shift) {
+		return (hash >> shift) & MASK;
+	}
+
+	size_type _hash_map_::index(std::uint32_t bitmap, std::uint32_t bit) {
+		/*
+			The index of a slot is the number of positions
+			in use before it.
+		*/
+
+		return std::bitset<32>(bitmap & (bit - 1)).count();
+	}
+
+	_hash_map_::trie_ptr _hash_map_::assoc(const trie_ptr& node, size_type shift, const _entry_& entry, bool_type& added, size_type edit) {
+		/*
+			Return a copy of the node with the entry set within it,
+			copying each node along the path to the entry.  A node
+			already owned by the builder editing it is modified in
+			place instead.
+		*/
+
+		std::shared_ptr<_trie_> copy;
+
+		if (edit && node && node->_edit == edit) {
+			copy = std::const_pointer_cast<_trie_>(node);
+		}
+		else {
+			copy = node ? make_pooled<_trie_>(*node) : make_pooled<_trie_>(_trie_{ 0, 0, {}, {} });
+
+			copy->_edit = edit;
+		}
+
+		if (shift >= HASH_BITS) {
+
+			for (_entry_& e : copy->_bucket) {
+
+				if (e._key == entry._key) {
+
+					e._value = entry._value;
+
+					return copy;
+				}
+			}
+
+			copy->_bucket.push_back(entry);
+			added = true;
+
+			return copy;
+		}
+
+		std::uint32_t bit = static_cast<std::uint32_t>(1) << position(entry._hash, shift);
+		size_type     i   = index(copy->_bitmap, bit);
+
+		if (!(copy->_bitmap & bit)) {
+
+			copy->_slots.insert(copy->_slots.begin() + i, _slot_{ trie_ptr(), entry });
+			copy->_bitmap |= bit;
+
+			added = true;
+
+			return copy;
+		}
+
+		_slot_& slot = copy->_slots[i];
+
+		if (slot._child) {
+
+			slot._child = assoc(slot._child, shift + BITS, entry, added, edit);
+		}
+		else if (slot._entry._hash == entry._hash && slot._entry._key == entry._key) {
+
+			slot._entry._value = entry._value;
+		}
+		else {
+			/*
+				Two keys share this position, so push both
+				down into a new node one level deeper.
+			*/
+
+			bool_type moved = false;
+
+			trie_ptr child = assoc(trie_ptr(), shift + BITS, slot._entry, moved, edit);
+
+			slot._child = assoc(child, shift + BITS, entry, added, edit);
+			slot._entry = _entry_();
+		}
+
+		return copy;
+	}
+
+	void _hash_map_::walk(const trie_ptr& node, std::vector<let>& keys, std::vector<let>& values) {
+
+		if (!node) {
+			return;
+		}
+
+		for (const _slot_& slot : node->_slots) {
+
+			if (slot._child) {
+				walk(slot._child, keys, values);
+			}
+			else {
+				keys.push_back(slot._entry._key);
+				values.push_back(slot._entry._value);
+			}
+		}
+
+		for (const _entry_& entry : node->_bucket) {
+			keys.push_back(entry._key);
+			values.push_back(entry._value);
+		}
+	}
+
+	/********************************************************************************************/
+	//
+	//                           '_hash_map_builder_' Class Implimentation
+	//
+	/********************************************************************************************/
+
+	_hash_map_builder_::_hash_map_builder_() : _map(), _edit(next_edit()) {
+	}
+
+	size_type _hash_map_builder_::size() const {
+		return _map._count;
+	}
+
+	void _hash_map_builder_::set(const let& key, const let& val) {
+
+		bool_type added = false;
+
+		_map._root = _hash_map_::assoc(_map._root, 0, _hash_map_::_entry_{ key.hash(), key, val }, added, _edit);
+
+		if (added) {
+			_map._count += 1;
+		}
+	}
+
+	_hash_map_ _hash_map_builder_::persistent() {
+
+		_hash_map_ m = _map;
+
+		_edit = next_edit();
+
+		return m;
+	}
+
+	size_type _hash_map_builder_::next_edit() {
+		/*
+			Edit ids are never reused, so a node marked by a
+			builder which has since finished is never modified.
+			Builders may be made upon any thread, so the count
+			is atomic.
+		*/
+
+		static std::atomic<size_type> edit(0);
+
+		return edit.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+
+} // end
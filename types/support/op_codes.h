@@ -21,7 +21,9 @@
 //			
 /********************************************************************************************/
 
-#include <map>
+#include <algorithm>
+#include <array>
+#include <string_view>
 
 namespace Olly {
 
@@ -59,7 +61,7 @@ namespace Olly {
 		STACK_OPERATORS,
 
 			end_scope_op, let_op, def_op, bind_op, return_op, relent_op,
-			LET_op,
+			LET_op, loop_op, LOOP_op,
 
 		FUNCTION_SCOPE_OPERATORS,
 
@@ -82,7 +84,7 @@ namespace Olly {
 
 			
 
-			imply_op, else_op, cond_op, is_const_op, is_var_op, LOOP_op, loop_op,
+			imply_op, else_op, cond_op, is_const_op, is_var_op,
 
 		EXTENDED_LOGIC_OPERATORS,
 
@@ -104,81 +106,302 @@ namespace Olly {
 
 	/********************************************************************************************/
 	//
-	//			                       Interpreter Operator Map
+	//			                       Interpreter Operator Table
+	//
+	//          The names of the operators are held in a constant table sorted by
+	//          name, so a word is classified by a binary search without building
+	//          a string.  The table must be kept in sorted order, which is checked
+	//          when compiled.  A second table, indexed by OP_CODE, holds the name
+	//          printed for each operator.
 	//			
 	/********************************************************************************************/
 
-	static const std::map<str_type, OP_CODE> OPERATORS = {
+	struct operator_entry {
+		std::string_view    name;
+		OP_CODE             code;
+	};
 
-		{ "none",            OP_CODE::NOTHING_OP },   
-		{ "nothing",         OP_CODE::NOTHING_OP },
+	constexpr operator_entry OPERATORS[] = {
+
+		{ "!=",            OP_CODE::ne_op },
+		{ "*",             OP_CODE::mul_op },
+		{ "**",            OP_CODE::pow_op },
+		{ "+",             OP_CODE::add_op },
+		{ "-",             OP_CODE::sub_op },
+		{ "-->",           OP_CODE::place_lead_op },
+		{ ".",             OP_CODE::index_op },
+		{ "/",             OP_CODE::div_op },
+		{ "//",            OP_CODE::fdiv_op },
+		{ "<",             OP_CODE::lt_op },
+		{ "<--",           OP_CODE::place_last_op },
+		{ "<<<",           OP_CODE::shift_lead_op },
+		{ "<=",            OP_CODE::le_op },
+		{ "=",             OP_CODE::eq_op },
+		{ ">",             OP_CODE::gt_op },
+		{ ">=",            OP_CODE::ge_op },
+		{ ">>>",           OP_CODE::shift_last_op },
+		{ "?",             OP_CODE::IS_op },
+		{ "NEG",           OP_CODE::NEG_op },
+		{ "NOT",           OP_CODE::NOT_op },
+		{ "PRINT",         OP_CODE::PRINT_op },
+		{ "_DEPTH_",       OP_CODE::DEPTH_op },
+		{ "_MAX_DEPTH_",   OP_CODE::MAX_DEPTH_op },
+		{ "_SET_STACK_",   OP_CODE::SET_STACK_op },
+		{ "_STACK_",       OP_CODE::STACK_op },
+		{ "and",           OP_CODE::and_op },
+		{ "bind",          OP_CODE::bind_op },
+		{ "cond",          OP_CODE::cond_op },
+		{ "const?",        OP_CODE::is_const_op },
+		{ "def",           OP_CODE::def_op },
+		{ "else",          OP_CODE::else_op },
+		{ "imply",         OP_CODE::imply_op },
+		{ "itr?",          OP_CODE::iterable_op },
+		{ "last",          OP_CODE::last_op },
+		{ "lead",          OP_CODE::lead_op },
+		{ "len",           OP_CODE::len_op },
+		{ "let",           OP_CODE::let_op },
+		{ "loop",          OP_CODE::loop_op },
+		{ "mod",           OP_CODE::mod_op },
+		{ "neg",           OP_CODE::neg_op },
+		{ "none",          OP_CODE::NOTHING_OP },
+		{ "not",           OP_CODE::not_op },
+		{ "nothing",       OP_CODE::NOTHING_OP },
+		{ "or",            OP_CODE::or_op },
+		{ "relent",        OP_CODE::relent_op },
+		{ "rem",           OP_CODE::rem_op },
+		{ "return",        OP_CODE::return_op },
+		{ "var?",          OP_CODE::is_var_op },
+		{ "xor",           OP_CODE::xor_op },
+	};
 
-		{ "neg",	             OP_CODE::neg_op },
-		{ "not",		         OP_CODE::not_op },
+	constexpr size_type OPERATOR_COUNT = sizeof(OPERATORS) / sizeof(OPERATORS[0]);
 
-		{ "?",			          OP_CODE::IS_op },
-		{ "NEG",	             OP_CODE::NEG_op },
-		{ "NOT",	             OP_CODE::NOT_op },
+	constexpr bool_type operators_are_sorted() {
 
-		{ "and",		         OP_CODE::and_op },
-		{ "or",			          OP_CODE::or_op },
-		{ "xor",		         OP_CODE::xor_op },
+		for (size_type i = 1; i < OPERATOR_COUNT; i += 1) {
 
-		{ "=",			          OP_CODE::eq_op },
-		{ "!=",			          OP_CODE::ne_op },
-		{ "<",			          OP_CODE::lt_op },
-		{ "<=",			          OP_CODE::le_op },
-		{ ">",			          OP_CODE::gt_op },
-		{ ">=",			          OP_CODE::ge_op },
+			if (!(OPERATORS[i - 1].name < OPERATORS[i].name)) {
+				return false;
+			}
+		}
 
-		{ "+",		             OP_CODE::add_op },
-		{ "-",		             OP_CODE::sub_op },
-		{ "*",		             OP_CODE::mul_op },
-		{ "/",		             OP_CODE::div_op },
-		{ "mod",	             OP_CODE::mod_op },
-		{ "//",		            OP_CODE::fdiv_op },
-		{ "rem",                 OP_CODE::rem_op },
-		{ "**",                  OP_CODE::pow_op },
+		return true;
+	}
 
-		{ "_STACK_",           OP_CODE::STACK_op },
-		{ "_DEPTH_",           OP_CODE::DEPTH_op },
-		{ "_MAX_DEPTH_",   OP_CODE::MAX_DEPTH_op },
-		{ "_SET_STACK_",   OP_CODE::SET_STACK_op },		
+	static_assert(operators_are_sorted(), "The OPERATORS table must be sorted by name.");
 
-		{ "let",	             OP_CODE::let_op },
-		{ "def",                 OP_CODE::def_op },
-		{ "bind",               OP_CODE::bind_op },
-		{ "return",           OP_CODE::return_op },
-		{ "relent",           OP_CODE::relent_op },
+	const operator_entry* find_operator(std::string_view name) {
+		/*
+			Return the entry of the operator with the name given,
+			or a null pointer if the name is not an operator.
+		*/
 
-		{ "len",                 OP_CODE::len_op },
-		{ "lead",               OP_CODE::lead_op },
-		{ "last",               OP_CODE::last_op },
-		{ "-->",          OP_CODE::place_lead_op },
-		{ "<--",          OP_CODE::place_last_op },
-		{ "<<<",          OP_CODE::shift_lead_op },
-		{ ">>>",          OP_CODE::shift_last_op },
-		{ "itr?",           OP_CODE::iterable_op },
-		{ ".",                 OP_CODE::index_op },
+		const operator_entry* end = OPERATORS + OPERATOR_COUNT;
 
-		{ "PRINT",	           OP_CODE::PRINT_op },
+		const operator_entry* it = std::lower_bound(OPERATORS, end, name, [](const operator_entry& e, std::string_view n) {
+			return e.name < n;
+		});
 
-		/****************************************************************************/
+		if (it != end && it->name == name) {
+			return it;
+		}
 
+		return nullptr;
+	}
 
+	constexpr size_type OP_CODE_COUNT = static_cast<size_type>(OP_CODE::END_OPERATORS_OP) + 1;
 
-		
-		
-		{ "loop",		  OP_CODE::loop_op },
-		{ "imply",		 OP_CODE::imply_op },   { "else",		 OP_CODE::else_op },
-		
-		
-		{ "cond",		  OP_CODE::cond_op },
-		{ "const?",	  OP_CODE::is_const_op },
-		{ "var?",		OP_CODE::is_var_op },
+	constexpr std::array<std::string_view, OP_CODE_COUNT> make_operator_names() {
+		/*
+			Where an operator has more than one name, the first
+			in sorted order is the one printed.
+		*/
+
+		std::array<std::string_view, OP_CODE_COUNT> names{};
+
+		for (size_type i = 0; i < OPERATOR_COUNT; i += 1) {
+
+			size_type code = static_cast<size_type>(OPERATORS[i].code);
 
+			if (names[code].empty()) {
+				names[code] = OPERATORS[i].name;
+			}
+		}
 
+		return names;
+	}
+
+	constexpr std::array<std::string_view, OP_CODE_COUNT> OPERATOR_NAMES = make_operator_names();
+
+
+	/********************************************************************************************/
+	//
+	//			                       Operator Code Layout
+	//
+	//          Compiled values are written with each operator as its OP_CODE, so a
+	//          binary file is only read back by a build which numbers the operators
+	//          the same way.  Every OP_CODE is listed here by name in the order of
+	//          the enum, which is checked when compiled, and the names and codes of
+	//          this table and of OPERATORS are hashed together.  Reordering, adding
+	//          or renaming an operator changes the hash written into every file.
+	//
+	/********************************************************************************************/
 
+	constexpr operator_entry OP_CODE_LAYOUT[] = {
+
+		{ "NOTHING_OP",                OP_CODE::NOTHING_OP },
+		{ "neg_op",                    OP_CODE::neg_op },
+		{ "not_op",                    OP_CODE::not_op },
+		{ "PREFIX_UNARY_OPERATORS",    OP_CODE::PREFIX_UNARY_OPERATORS },
+
+		{ "IS_op",                     OP_CODE::IS_op },
+		{ "NEG_op",                    OP_CODE::NEG_op },
+		{ "NOT_op",                    OP_CODE::NOT_op },
+		{ "POSTFIX_UNARY_OPERATORS",   OP_CODE::POSTFIX_UNARY_OPERATORS },
+
+		{ "and_op",                    OP_CODE::and_op },
+		{ "or_op",                     OP_CODE::or_op },
+		{ "xor_op",                    OP_CODE::xor_op },
+		{ "eq_op",                     OP_CODE::eq_op },
+		{ "ne_op",                     OP_CODE::ne_op },
+		{ "lt_op",                     OP_CODE::lt_op },
+		{ "le_op",                     OP_CODE::le_op },
+		{ "gt_op",                     OP_CODE::gt_op },
+		{ "ge_op",                     OP_CODE::ge_op },
+		{ "add_op",                    OP_CODE::add_op },
+		{ "sub_op",                    OP_CODE::sub_op },
+		{ "mul_op",                    OP_CODE::mul_op },
+		{ "div_op",                    OP_CODE::div_op },
+		{ "mod_op",                    OP_CODE::mod_op },
+		{ "fdiv_op",                   OP_CODE::fdiv_op },
+		{ "rem_op",                    OP_CODE::rem_op },
+		{ "pow_op",                    OP_CODE::pow_op },
+		{ "INFIX_BINARY_OPERATORS",    OP_CODE::INFIX_BINARY_OPERATORS },
+
+		{ "AND_op",                    OP_CODE::AND_op },
+		{ "OR_op",                     OP_CODE::OR_op },
+		{ "XOR_op",                    OP_CODE::XOR_op },
+		{ "EQ_op",                     OP_CODE::EQ_op },
+		{ "NE_op",                     OP_CODE::NE_op },
+		{ "LT_op",                     OP_CODE::LT_op },
+		{ "LE_op",                     OP_CODE::LE_op },
+		{ "GT_op",                     OP_CODE::GT_op },
+		{ "GE_op",                     OP_CODE::GE_op },
+		{ "ADD_op",                    OP_CODE::ADD_op },
+		{ "SUB_op",                    OP_CODE::SUB_op },
+		{ "MUL_op",                    OP_CODE::MUL_op },
+		{ "DIV_op",                    OP_CODE::DIV_op },
+		{ "MOD_op",                    OP_CODE::MOD_op },
+		{ "FDIV_op",                   OP_CODE::FDIV_op },
+		{ "REM_op",                    OP_CODE::REM_op },
+		{ "POW_op",                    OP_CODE::POW_op },
+		{ "POSTFIX_BINARY_OPERATORS",  OP_CODE::POSTFIX_BINARY_OPERATORS },
+
+		{ "STACK_op",                  OP_CODE::STACK_op },
+		{ "DEPTH_op",                  OP_CODE::DEPTH_op },
+		{ "MAX_DEPTH_op",              OP_CODE::MAX_DEPTH_op },
+		{ "SET_STACK_op",              OP_CODE::SET_STACK_op },
+		{ "STACK_OPERATORS",           OP_CODE::STACK_OPERATORS },
+
+		{ "end_scope_op",              OP_CODE::end_scope_op },
+		{ "let_op",                    OP_CODE::let_op },
+		{ "def_op",                    OP_CODE::def_op },
+		{ "bind_op",                   OP_CODE::bind_op },
+		{ "return_op",                 OP_CODE::return_op },
+		{ "relent_op",                 OP_CODE::relent_op },
+		{ "LET_op",                    OP_CODE::LET_op },
+		{ "loop_op",                   OP_CODE::loop_op },
+		{ "LOOP_op",                   OP_CODE::LOOP_op },
+		{ "FUNCTION_SCOPE_OPERATORS",  OP_CODE::FUNCTION_SCOPE_OPERATORS },
+
+		{ "LEN_op",                    OP_CODE::LEN_op },
+		{ "len_op",                    OP_CODE::len_op },
+		{ "LEAD_op",                   OP_CODE::LEAD_op },
+		{ "lead_op",                   OP_CODE::lead_op },
+		{ "LAST_op",                   OP_CODE::LAST_op },
+		{ "last_op",                   OP_CODE::last_op },
+		{ "PLACE_LEAD_op",             OP_CODE::PLACE_LEAD_op },
+		{ "place_lead_op",             OP_CODE::place_lead_op },
+		{ "PLACE_LAST_op",             OP_CODE::PLACE_LAST_op },
+		{ "place_last_op",             OP_CODE::place_last_op },
+		{ "SHIFT_LEAD_op",             OP_CODE::SHIFT_LEAD_op },
+		{ "shift_lead_op",             OP_CODE::shift_lead_op },
+		{ "SHIFT_LAST_op",             OP_CODE::SHIFT_LAST_op },
+		{ "shift_last_op",             OP_CODE::shift_last_op },
+		{ "iterable_op",               OP_CODE::iterable_op },
+		{ "GET_op",                    OP_CODE::GET_op },
+		{ "SET_op",                    OP_CODE::SET_op },
+		{ "index_op",                  OP_CODE::index_op },
+		{ "iter_op",                   OP_CODE::iter_op },
+		{ "ITER_op",                   OP_CODE::ITER_op },
+		{ "SEQUENCE_OPERATORS",        OP_CODE::SEQUENCE_OPERATORS },
+
+		{ "PRINT_op",                  OP_CODE::PRINT_op },
+		{ "IO_OPERATORS",              OP_CODE::IO_OPERATORS },
+
+		{ "imply_op",                  OP_CODE::imply_op },
+		{ "else_op",                   OP_CODE::else_op },
+		{ "cond_op",                   OP_CODE::cond_op },
+		{ "is_const_op",               OP_CODE::is_const_op },
+		{ "is_var_op",                 OP_CODE::is_var_op },
+		{ "EXTENDED_LOGIC_OPERATORS",  OP_CODE::EXTENDED_LOGIC_OPERATORS },
+
+		{ "ABSTRACTION_OPERATORS",     OP_CODE::ABSTRACTION_OPERATORS },
+
+		{ "BREAK_op",                  OP_CODE::BREAK_op },
+		{ "END_op",                    OP_CODE::END_op },
+		{ "EVALUATION_OPERATORS",      OP_CODE::EVALUATION_OPERATORS },
+
+		{ "IN_EQ_op",                  OP_CODE::IN_EQ_op },
+		{ "IN_NE_op",                  OP_CODE::IN_NE_op },
+		{ "IN_LT_op",                  OP_CODE::IN_LT_op },
+		{ "IN_LE_op",                  OP_CODE::IN_LE_op },
+		{ "IN_GT_op",                  OP_CODE::IN_GT_op },
+		{ "IN_GE_op",                  OP_CODE::IN_GE_op },
+		{ "IS_TRUE_op",                OP_CODE::IS_TRUE_op },
+		{ "IF_TRUE_op",                OP_CODE::IF_TRUE_op },
+		{ "if_op",                     OP_CODE::if_op },
+		{ "END_OPERATORS_OP",          OP_CODE::END_OPERATORS_OP },
 	};
 
-} // end
+	constexpr bool_type op_code_layout_matches() {
+
+		if (sizeof(OP_CODE_LAYOUT) / sizeof(OP_CODE_LAYOUT[0]) != OP_CODE_COUNT) {
+			return false;
+		}
+
+		for (size_type i = 0; i < OP_CODE_COUNT; i += 1) {
+
+			if (static_cast<size_type>(OP_CODE_LAYOUT[i].code) != i) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static_assert(op_code_layout_matches(), "The OP_CODE_LAYOUT table must list every OP_CODE in order.");
+
+	constexpr size_type hash_operators(const operator_entry* entries, size_type count, size_type hash) {
+		/*
+			A 64 bit FNV-1a hash of the name and code of each
+			entry, continuing from the hash given.
+		*/
+
+		for (size_type i = 0; i < count; i += 1) {
+
+			for (char c : entries[i].name) {
+				hash ^= static_cast<unsigned char>(c);
+				hash *= 1099511628211ull;
+			}
+
+			hash ^= static_cast<size_type>(entries[i].code);
+			hash *= 1099511628211ull;
+		}
+
+		return hash;
+	}
+
+	constexpr size_type OP_CODE_HASH = hash_operators(OPERATORS, OPERATOR_COUNT, hash_operators(OP_CODE_LAYOUT, OP_CODE_COUNT, 14695981039346656037ull));
+
+} // end
\ No newline at end of file
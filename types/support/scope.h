@@ -0,0 +1,319 @@
+#pragma once
+
+/********************************************************************************************/
+//
+//			Copyright 2019 Max J. Martin
+//
+//			This file is part of Oliver.
+//
+//			Oliver is free software : you can redistribute it and / or modify
+//			it under the terms of the GNU General Public License as published by
+//			the Free Software Foundation, either version 3 of the License, or
+//			(at your option) any later version.
+//
+//			Oliver is distributed in the hope that it will be useful,
+//			but WITHOUT ANY WARRANTY; without even the implied warranty of
+//			MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//			GNU General Public License for more details.
+//
+//			You should have received a copy of the GNU General Public License
+//			along with Oliver.If not, see < https://www.gnu.org/licenses/>.
+//
+/********************************************************************************************/
+
+#include <memory>
+#include <vector>
+
+#include "..\..\let.h"
+
+namespace Olly {
+
+	/********************************************************************************************/
+	//
+	//                                 'scope_address' Definition
+	//
+	//          A scope address locates a variable by the depth of its scope, counted
+	//          from the innermost scope, and its slot within that scope.  Scoping is
+	//          dynamic, so an address is found as a symbol is looked up.
+	//
+	/********************************************************************************************/
+
+	struct scope_address {
+		size_type  depth;
+		size_type   slot;
+	};
+
+	/********************************************************************************************/
+	//
+	//                                   'scope' Class Definition
+	//
+	//          The scope class is a single frame of variables.  Symbol ids and values
+	//          are held in flat arrays, and a variable keeps its slot for the life
+	//          of the scope, so an address into it remains valid.  A small scope is
+	//          searched in order, and a larger one through a hashed index of slots.
+	//
+	//          A scope may reference a shared and immutable enclosure, which holds
+	//          the variables captured by a lambda.  The slots of the enclosure come
+	//          first, followed by the variables bound within the scope itself, which
+	//          shadow any of the same name within the enclosure.
+	//
+	//          A scope standing in for its caller on a tail call also holds the
+	//          variables of the caller, ahead of the enclosure.  They are visible
+	//          to a search, as the caller's scope would have been, but belong to
+	//          neither the lambda nor its arguments, so are never captured.
+	//
+	/********************************************************************************************/
+
+	class scope;
+
+	typedef std::shared_ptr<const scope>  enclosure_type;
+
+	class scope {
+
+		typedef std::vector<size_type>  id_type;
+		typedef std::vector<let>       value_type;
+
+		static const size_type SCAN_LIMIT = 8;    // The most ids searched in order, before an index is kept.
+
+		enclosure_type   _enclosure;
+		enclosure_type      _caller;    // The variables of the caller replaced on a tail call.
+		size_type           _hidden;    // The number of slots within the caller.
+		size_type           _offset;    // The number of slots within the caller and enclosure.
+		id_type               _ids;
+		value_type         _values;
+		id_type             _index;    // An open addressed table of each local slot plus one, or empty.
+
+	public:
+
+		static const size_type npos;
+
+		scope();
+		scope(const enclosure_type& enclosure);
+
+		size_type           size()                                     const;
+		size_type           find(size_type id)                         const;  // The slot of a symbol id, or npos.
+
+		size_type             id(size_type slot)                       const;
+		const let&           get(size_type slot)                       const;
+		size_type            set(size_type id, const let& val);                // Bind a symbol id, returning its slot.
+
+		scope            capture(size_type except)                     const;  // A flat copy of each variable, less the caller's.
+		scope            replace(const scope& caller)                  const;  // This scope, standing in for its caller.
+
+	private:
+
+		size_type     find_local(size_type id)                         const;
+		void         index_local(size_type slot);                              // Add a local slot to the index, building it once needed.
+		scope            collect(size_type except, size_type from)     const;
+	};
+
+	/********************************************************************************************/
+	//
+	//                                 'scope' Class Implimentation
+	//
+	/********************************************************************************************/
+
+	const size_type scope::npos = static_cast<size_type>(-1);
+
+	scope::scope() : _enclosure(), _caller(), _hidden(0), _offset(0), _ids(), _values(), _index() {
+	}
+
+	scope::scope(const enclosure_type& enclosure) : _enclosure(enclosure), _caller(), _hidden(0), _offset(0), _ids(), _values(), _index() {
+
+		if (_enclosure) {
+			_offset = _enclosure->size();
+		}
+	}
+
+	size_type scope::size() const {
+		return _offset + _ids.size();
+	}
+
+	size_type scope::find(size_type id) const {
+
+		size_type slot = find_local(id);
+
+		if (slot != npos) {
+			return _offset + slot;
+		}
+
+		if (_enclosure) {
+
+			slot = _enclosure->find(id);
+
+			if (slot != npos) {
+				return _hidden + slot;
+			}
+		}
+
+		if (_caller) {
+			return _caller->find(id);
+		}
+
+		return npos;
+	}
+
+	size_type scope::id(size_type slot) const {
+
+		if (slot >= _offset) {
+			return _ids[slot - _offset];
+		}
+
+		if (slot >= _hidden) {
+			return _enclosure->id(slot - _hidden);
+		}
+
+		return _caller->id(slot);
+	}
+
+	const let& scope::get(size_type slot) const {
+
+		if (slot >= _offset) {
+			return _values[slot - _offset];
+		}
+
+		if (slot >= _hidden) {
+			return _enclosure->get(slot - _hidden);
+		}
+
+		return _caller->get(slot);
+	}
+
+	size_type scope::set(size_type id, const let& val) {
+
+		size_type slot = find_local(id);
+
+		if (slot != npos) {
+
+			_values[slot] = val;
+
+			return _offset + slot;
+		}
+
+		_ids.emplace_back(id);
+		_values.emplace_back(val);
+
+		index_local(_ids.size() - 1);
+
+		return size() - 1;
+	}
+
+	scope scope::capture(size_type except) const {
+		return collect(except, _hidden);
+	}
+
+	scope scope::replace(const scope& caller) const {
+		/*
+			Build the scope which takes the place of the caller's scope on a
+			tail call.  The caller's variables are kept, beneath those of this
+			scope's own enclosure, so each name resolves as it would with the
+			caller's scope still in place.  They are held apart from the
+			enclosure, so a lambda defined within the call can not capture them.
+		*/
+
+		scope s(_enclosure);
+
+		s._caller = std::make_shared<const scope>(caller.collect(npos, 0));
+		s._hidden = s._caller->size();
+		s._offset += s._hidden;
+
+		s._ids    = _ids;
+		s._values = _values;
+		s._index  = _index;
+
+		return s;
+	}
+
+	size_type scope::find_local(size_type id) const {
+
+		if (_index.empty()) {
+
+			for (size_type i = 0, stop = _ids.size(); i < stop; i += 1) {
+
+				if (_ids[i] == id) {
+					return i;
+				}
+			}
+
+			return npos;
+		}
+
+		/*
+			Symbol ids are interned in order, so the low bits of
+			an id spread the ids of a scope across the table.
+		*/
+
+		size_type mask = _index.size() - 1;
+
+		for (size_type h = id & mask; _index[h]; h = (h + 1) & mask) {
+
+			if (_ids[_index[h] - 1] == id) {
+				return _index[h] - 1;
+			}
+		}
+
+		return npos;
+	}
+
+	void scope::index_local(size_type slot) {
+
+		size_type count = _ids.size();
+
+		if (count <= SCAN_LIMIT) {
+			return;
+		}
+
+		if (count * 2 > _index.size()) {
+			/*
+				Keep the table at most half full, so each search
+				ends soon upon an empty entry.
+			*/
+
+			size_type width = SCAN_LIMIT * 4;
+
+			while (width < count * 4) {
+				width *= 2;
+			}
+
+			_index.assign(width, 0);
+
+			for (size_type i = 0; i < count; i += 1) {
+				index_local(i);
+			}
+
+			return;
+		}
+
+		size_type mask = _index.size() - 1;
+		size_type h    = _ids[slot] & mask;
+
+		while (_index[h]) {
+			h = (h + 1) & mask;
+		}
+
+		_index[h] = slot + 1;
+	}
+
+	scope scope::collect(size_type except, size_type from) const {
+		/*
+			A flat copy of each variable visible from the slot given on.
+			Each slot shadows those beneath it, so the slots are set in
+			order, and a later slot of the same id replaces the value.
+			The copy is indexed as it grows, so this is a single pass.
+		*/
+
+		scope s;
+
+		for (size_type slot = from, stop = size(); slot < stop; slot += 1) {
+
+			size_type i = id(slot);
+
+			if (i != except) {
+				s.set(i, get(slot));
+			}
+		}
+
+		return s;
+	}
+
+} // end
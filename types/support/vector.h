@@ -0,0 +1,910 @@
+#pragma once
+
+/********************************************************************************************/
+//
+//			Copyright 2019 Max J. Martin
+//
+//			This file is part of Oliver.
+//
+//			Oliver is free software : you can redistribute it and / or modify
+//			it under the terms of the GNU General Public License as published by
+//			the Free Software Foundation, either version 3 of the License, or
+//			(at your option) any later version.
+//
+//			Oliver is distributed in the hope that it will be useful,
+//			but WITHOUT ANY WARRANTY; without even the implied warranty of
+//			MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//			GNU General Public License for more details.
+//
+//			You should have received a copy of the GNU General Public License
+//			along with Oliver.If not, see < https://www.gnu.org/licenses/>.
+//
+/********************************************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "..\..\let.h"
+
+namespace Olly {
+
+	/********************************************************************************************/
+	//
+	//                                '_vector_' Class Definition
+	//
+	//          The _vector_ class is a persistent sequence used to back the sequence
+	//          data types.  Elements are held in contiguous chunks of 32 within a
+	//          32 way trie, with the most recent chunk kept aside as a tail.  Every
+	//          modification returns a new _vector_ which shares all unchanged chunks
+	//          with the original.
+	//
+	//          A vector is made of two such tries.  Elements placed at the last are
+	//          appended to the back trie, and elements placed at the lead are appended
+	//          to the front trie, so it holds them in reverse order.  Elements shifted
+	//          from either end are popped from the trie at that end, or skipped by an
+	//          offset once that trie is empty.  This gives constant time lead, last,
+	//          and reverse, amortized constant time place and shift at either end,
+	//          and logarithmic time indexing wherever an element was placed.
+	//
+	/********************************************************************************************/
+
+	class _vector_ {
+
+		static const size_type BITS  = 5;
+		static const size_type WIDTH = 1 << BITS;
+		static const size_type MASK  = WIDTH - 1;
+
+		struct _chunk_;
+
+		typedef std::shared_ptr<const _chunk_>    chunk_ptr;
+
+		struct _chunk_ {
+			std::vector<chunk_ptr>  _branches;    // The children of an interior trie node.
+			std::vector<let, pool_allocator<let>>  _values;    // The elements of a leaf or the tail, from the pool of the thread.
+		};
+
+		struct _trie_ {
+			/*
+				A persistent array, which grows and shrinks at its last,
+				and skips the elements removed from its lead.  Skipped
+				chunks are released, and the positions are rebased once
+				a whole branch of the root has been skipped.
+			*/
+
+			chunk_ptr    _root;      // The trie of full chunks.
+			chunk_ptr    _tail;      // The last, partially filled, chunk.
+			size_type    _shift;     // The bit shift of the root level of the trie.
+			size_type    _count;     // The number of elements in the trie and tail.
+			size_type    _start;     // The number of elements skipped at the lead of the trie.
+
+			_trie_();
+
+			size_type           size()                                     const;
+			const let&            at(size_type i)                          const;  // The element at the position 'i' past the start.
+
+			_trie_              push(let other)                            const;
+			_trie_               pop()                                     const;
+			_trie_              skip()                                     const;
+			_trie_               set(size_type i, const let& other)        const;
+
+			size_type    tail_offset()                                     const;
+			const _chunk_* chunk_for(size_type i)                          const;  // The chunk of the element at the absolute position 'i'.
+			_trie_         tail_push()                                     const;
+
+			chunk_ptr      push_tail(size_type level, const chunk_ptr& parent, const chunk_ptr& tail)  const;
+			chunk_ptr       pop_tail(size_type level, const chunk_ptr& node)                           const;
+			chunk_ptr       set_path(size_type level, const chunk_ptr& node, size_type i, const let& other)  const;
+
+			static chunk_ptr  new_path(size_type level, const chunk_ptr& node);
+			static chunk_ptr drop_path(size_type level, const chunk_ptr& node, size_type start);  // Release the chunks before 'start'.
+			static _trie_        build(const std::vector<let>& items);
+		};
+
+		class _cursor_ {
+			/*
+				Steps through the elements of a vector in order.  The
+				elements are read a run at a time from within a chunk,
+				so no element is copied, and no chunk is looked up twice.
+			*/
+
+			const _vector_&   _vector;
+			size_type          _index;    // The position of the next element.
+			const let*          _item;
+			size_type           _left;    // The elements remaining within the run.
+			bool_type        _reverse;    // Does the run step back through the chunk.
+
+		public:
+
+			_cursor_(const _vector_& v);
+
+			const let&          next();                                        // The next element, which must exist.
+
+		private:
+
+			void              locate();
+		};
+
+		_trie_      _front;      // Elements placed at the lead, held in reverse order.
+		_trie_       _back;
+		hash_cache   _hash;      // The hash of the elements, once computed.
+
+	public:
+
+		_vector_();
+		_vector_(const std::vector<let>& items);                               // The elements in order.
+
+		bool_type          is()                                        const;  // Does the vector hold any elements.
+		size_type        size()                                        const;  // The number of elements.
+		const let&         at(size_type i)                             const;  // The element at the zero based position 'i'.
+
+		let              lead()                                        const;
+		let              last()                                        const;
+		_vector_   place_lead(let other)                               const;  // The element is moved into place.
+		_vector_   shift_lead()                                        const;
+		_vector_   place_last(let other)                               const;
+		_vector_   shift_last()                                        const;
+		_vector_          set(size_type i, const let& other)           const;  // Replace the element at the zero based position 'i'.
+		_vector_      reverse()                                        const;
+
+		real_type        comp(const _vector_& other)                   const;  // 0.0 if each element is equal, else NaN.
+		size_type        hash()                                        const;  // Combine the hash of each element.
+
+		void              str(output_sink& out)                        const;  // Print the elements separated by spaces.
+		void             repr(output_sink& out)                        const;
+		void           encode(encoder& out)                            const;  // Write the size, then each element.
+		void            items(std::vector<let>& out)                   const;  // Append each element in order.
+
+	private:
+
+		_vector_(_trie_&& front, const _trie_& back);
+		_vector_(const _trie_& front, _trie_&& back);
+
+		friend class _vector_builder_;
+	};
+
+	/********************************************************************************************/
+	//
+	//                             '_vector_builder_' Class Definition
+	//
+	//          The _vector_builder_ class is a transient, used to build a _vector_ one
+	//          element at a time.  Elements are appended in place to a tail owned by the
+	//          builder alone, and each full tail is moved into the trie, so building a
+	//          vector of n elements makes about n / 32 allocations rather than n whole
+	//          vectors.  As with place_last, nothing is never appended.  The finished
+	//          vector is taken in constant time, which leaves the builder empty.
+	//
+	/********************************************************************************************/
+
+	class _vector_builder_ {
+
+		typedef std::shared_ptr<_vector_::_chunk_>  tail_ptr;
+
+		_vector_     _vector;    // The elements within full chunks.
+		tail_ptr       _tail;    // The chunk being filled.
+
+	public:
+
+		_vector_builder_();
+
+		size_type        size()                                        const;
+
+		void       place_last(let other);
+		_vector_   persistent();                                               // Take the vector built.
+
+	private:
+		_vector_builder_(const _vector_builder_& obj) = delete;
+	};
+
+	/********************************************************************************************/
+	//
+	//                               '_vector_' Class Implimentation
+	//
+	/********************************************************************************************/
+
+	_vector_::_vector_() : _front(), _back(), _hash() {
+	}
+
+	_vector_::_vector_(const std::vector<let>& items) : _front(), _back(_trie_::build(items)), _hash() {
+	}
+
+	_vector_::_vector_(_trie_&& front, const _trie_& back) : _front(std::move(front)), _back(back), _hash() {
+	}
+
+	_vector_::_vector_(const _trie_& front, _trie_&& back) : _front(front), _back(std::move(back)), _hash() {
+	}
+
+	bool_type _vector_::is() const {
+		return size() > 0;
+	}
+
+	size_type _vector_::size() const {
+		return _front.size() + _back.size();
+	}
+
+	const let& _vector_::at(size_type i) const {
+
+		size_type front = _front.size();
+
+		if (i < front) {
+			return _front.at(front - i - 1);
+		}
+
+		return _back.at(i - front);
+	}
+
+	let _vector_::lead() const {
+
+		if (!is()) {
+			return nothing();
+		}
+
+		return at(0);
+	}
+
+	let _vector_::last() const {
+
+		if (!is()) {
+			return nothing();
+		}
+
+		return at(size() - 1);
+	}
+
+	_vector_ _vector_::place_lead(let other) const {
+
+		if (other.is_nothing()) {
+			return *this;
+		}
+
+		return _vector_(_front.push(std::move(other)), _back);
+	}
+
+	_vector_ _vector_::shift_lead() const {
+
+		if (!is()) {
+			return *this;
+		}
+
+		if (_front.size()) {
+			return _vector_(_front.pop(), _back);
+		}
+
+		return _vector_(_front, _back.skip());
+	}
+
+	_vector_ _vector_::place_last(let other) const {
+
+		if (other.is_nothing()) {
+			return *this;
+		}
+
+		return _vector_(_front, _back.push(std::move(other)));
+	}
+
+	_vector_ _vector_::shift_last() const {
+
+		if (!is()) {
+			return *this;
+		}
+
+		if (_back.size()) {
+			return _vector_(_front, _back.pop());
+		}
+
+		return _vector_(_front.skip(), _back);
+	}
+
+	_vector_ _vector_::set(size_type i, const let& other) const {
+		/*
+			Copy only the chunks along the path to the element.
+		*/
+
+		size_type front = _front.size();
+
+		if (i < front) {
+			return _vector_(_front.set(front - i - 1, other), _back);
+		}
+
+		return _vector_(_front, _back.set(i - front, other));
+	}
+
+	_vector_ _vector_::reverse() const {
+		/*
+			The front trie holds its elements in reverse order, so
+			exchanging the two tries reverses the whole sequence.
+		*/
+
+		return _vector_(_trie_(_back), _front);
+	}
+
+	real_type _vector_::comp(const _vector_& other) const {
+
+		if (size() != other.size()) {
+			return NOT_A_NUMBER;
+		}
+
+		_cursor_ a(*this);
+		_cursor_ b(other);
+
+		for (size_type i = 0, stop = size(); i < stop; i += 1) {
+
+			if (a.next() != b.next()) {
+				return NOT_A_NUMBER;
+			}
+		}
+
+		return 0.0;
+	}
+
+	size_type _vector_::hash() const {
+		/*
+			The hash is computed from each element when first
+			requested, and kept for each call after.  Copies
+			are made to be modified, so they start without it.
+		*/
+
+		if (_hash.is()) {
+			return _hash.get();
+		}
+
+		_cursor_ items(*this);
+
+		size_type hash = size();
+
+		for (size_type i = 0, stop = size(); i < stop; i += 1) {
+			hash = hash_combine(hash, items.next().hash());
+		}
+
+		return _hash.set(hash);
+	}
+
+	void _vector_::str(output_sink& out) const {
+
+		_cursor_ items(*this);
+
+		for (size_type i = 0, stop = size(); i < stop; i += 1) {
+
+			if (i) {
+				out << " ";
+			}
+
+			Olly::str(out, items.next());
+		}
+	}
+
+	void _vector_::repr(output_sink& out) const {
+
+		_cursor_ items(*this);
+
+		for (size_type i = 0, stop = size(); i < stop; i += 1) {
+
+			if (i) {
+				out << " ";
+			}
+
+			items.next().repr(out);
+		}
+	}
+
+	void _vector_::encode(encoder& out) const {
+
+		_cursor_ items(*this);
+
+		out.write_size(size());
+
+		for (size_type i = 0, stop = size(); i < stop; i += 1) {
+			items.next().encode(out);
+		}
+	}
+
+	void _vector_::items(std::vector<let>& out) const {
+
+		_cursor_ items(*this);
+
+		out.reserve(out.size() + size());
+
+		for (size_type i = 0, stop = size(); i < stop; i += 1) {
+			out.emplace_back(items.next());
+		}
+	}
+
+	/********************************************************************************************/
+	//
+	//                           '_vector_::_cursor_' Class Implimentation
+	//
+	/********************************************************************************************/
+
+	_vector_::_cursor_::_cursor_(const _vector_& v) : _vector(v), _index(0), _item(nullptr), _left(0), _reverse(false) {
+	}
+
+	const let& _vector_::_cursor_::next() {
+
+		if (!_left) {
+			locate();
+		}
+
+		const let& item = *_item;
+
+		_index += 1;
+		_left  -= 1;
+
+		if (_left) {
+			_item = _reverse ? _item - 1 : _item + 1;
+		}
+
+		return item;
+	}
+
+	void _vector_::_cursor_::locate() {
+		/*
+			Find the run of elements within the chunk of the next
+			element.  A run within the front trie steps back toward
+			its start, and a run within the back trie steps on toward
+			its count.
+		*/
+
+		size_type front = _vector._front.size();
+
+		if (_index < front) {
+
+			const _trie_& t = _vector._front;
+
+			size_type i   = t._start + front - _index - 1;
+			size_type low = std::max(i & ~MASK, t._start);
+
+			_item    = &t.chunk_for(i)->_values[i & MASK];
+			_left    = i - low + 1;
+			_reverse = true;
+
+			return;
+		}
+
+		const _trie_& t = _vector._back;
+
+		size_type i = t._start + _index - front;
+
+		const _chunk_* chunk = t.chunk_for(i);
+
+		_item    = &chunk->_values[i & MASK];
+		_left    = std::min(chunk->_values.size() - (i & MASK), t._count - i);
+		_reverse = false;
+	}
+
+	/********************************************************************************************/
+	//
+	//                            '_vector_::_trie_' Class Implimentation
+	//
+	/********************************************************************************************/
+
+	_vector_::_trie_::_trie_() : _root(), _tail(), _shift(BITS), _count(0), _start(0) {
+	}
+
+	size_type _vector_::_trie_::size() const {
+		return _count - _start;
+	}
+
+	const let& _vector_::_trie_::at(size_type i) const {
+
+		i += _start;
+
+		return chunk_for(i)->_values[i & MASK];
+	}
+
+	_vector_::_trie_ _vector_::_trie_::push(let other) const {
+
+		if (_count - tail_offset() < WIDTH) {
+			/*
+				Room remains in the tail, so copy it with the new element.
+			*/
+			auto tail = make_pooled<_chunk_>();
+
+			if (_tail) {
+
+				size_type live = _count - tail_offset();
+
+				tail->_values.reserve(live + 1);
+				tail->_values.assign(_tail->_values.begin(), _tail->_values.begin() + live);
+			}
+
+			tail->_values.emplace_back(std::move(other));
+
+			_trie_ t;
+
+			t._root  = _root;
+			t._tail  = std::move(tail);
+			t._shift = _shift;
+			t._count = _count + 1;
+			t._start = _start;
+
+			return t;
+		}
+
+		/*
+			The tail is full, so move it into the trie and begin a new tail.
+		*/
+
+		_trie_ t = tail_push();
+
+		auto tail = make_pooled<_chunk_>();
+
+		tail->_values.reserve(WIDTH);
+		tail->_values.emplace_back(std::move(other));
+
+		t._tail   = std::move(tail);
+		t._count += 1;
+
+		return t;
+	}
+
+	_vector_::_trie_ _vector_::_trie_::pop() const {
+
+		if (size() == 1) {
+			return _trie_();
+		}
+
+		_trie_ t = *this;
+
+		t._count -= 1;
+
+		if (_count - tail_offset() > 1) {
+			/*
+				The tail is shared rather than copied, and the element
+				past the new count is ignored until the tail is replaced.
+			*/
+			return t;
+		}
+
+		/*
+			The tail would be empty, so the last chunk of the trie becomes the tail.
+		*/
+
+		const _chunk_* last = chunk_for(_count - 2);
+
+		t._tail = make_pooled<_chunk_>(*last);
+
+		chunk_ptr root = pop_tail(_shift, _root);
+
+		if (_shift > BITS && root->_branches.size() < 2) {
+
+			root = root->_branches.front();
+
+			t._shift -= BITS;
+		}
+
+		t._root = root;
+
+		return t;
+	}
+
+	_vector_::_trie_ _vector_::_trie_::skip() const {
+
+		if (size() == 1) {
+			/*
+				Release the chunks once every element has been skipped.
+			*/
+			return _trie_();
+		}
+
+		_trie_ t = *this;
+
+		t._start += 1;
+
+		if (t._start & MASK) {
+			return t;
+		}
+
+		/*
+			A whole chunk has been skipped.  Once the whole trie, or
+			the first branch of the root, has been skipped it is
+			removed, and the positions move down by the elements it
+			held.  Otherwise the chunk is released from its parent.
+		*/
+
+		size_type offset = t.tail_offset();
+		size_type span   = size_type(1) << t._shift;
+
+		if (t._start >= offset) {
+
+			t._root.reset();
+
+			t._shift  = BITS;
+			t._count -= offset;
+			t._start -= offset;
+
+			return t;
+		}
+
+		if (t._start >= span) {
+
+			auto root = make_pooled<_chunk_>(*t._root);
+
+			root->_branches.erase(root->_branches.begin());
+
+			t._count -= span;
+			t._start -= span;
+
+			chunk_ptr node = root;
+
+			while (t._shift > BITS && node->_branches.size() == 1) {
+
+				node = node->_branches.front();
+
+				t._shift -= BITS;
+			}
+
+			t._root = node;
+
+			return t;
+		}
+
+		t._root = drop_path(t._shift, t._root, t._start);
+
+		return t;
+	}
+
+	_vector_::_trie_ _vector_::_trie_::set(size_type i, const let& other) const {
+
+		_trie_ t = *this;
+
+		i += _start;
+
+		if (i >= tail_offset()) {
+
+			auto tail = make_pooled<_chunk_>(*_tail);
+
+			tail->_values[i & MASK] = other;
+
+			t._tail = tail;
+
+			return t;
+		}
+
+		t._root = set_path(_shift, _root, i, other);
+
+		return t;
+	}
+
+	size_type _vector_::_trie_::tail_offset() const {
+
+		if (_count < WIDTH) {
+			return 0;
+		}
+
+		return ((_count - 1) >> BITS) << BITS;
+	}
+
+	const _vector_::_chunk_* _vector_::_trie_::chunk_for(size_type i) const {
+
+		if (i >= tail_offset()) {
+			return _tail.get();
+		}
+
+		const _chunk_* node = _root.get();
+
+		for (size_type level = _shift; level > 0; level -= BITS) {
+			node = node->_branches[(i >> level) & MASK].get();
+		}
+
+		return node;
+	}
+
+	_vector_::_trie_ _vector_::_trie_::tail_push() const {
+
+		_trie_ t = *this;
+
+		if ((_count >> BITS) > (size_type(1) << _shift)) {
+			/*
+				The trie is full, so grow it by one level.
+			*/
+			auto root = make_pooled<_chunk_>();
+
+			root->_branches.emplace_back(_root);
+			root->_branches.emplace_back(new_path(_shift, _tail));
+
+			t._root   = root;
+			t._shift += BITS;
+		}
+		else {
+			t._root = push_tail(_shift, _root, _tail);
+		}
+
+		t._tail = chunk_ptr();
+
+		return t;
+	}
+
+	_vector_::_trie_ _vector_::_trie_::build(const std::vector<let>& items) {
+		/*
+			Fill whole chunks directly rather than copying the tail
+			for each element.
+		*/
+
+		_trie_ t;
+
+		for (size_type i = 0, stop = items.size(); i < stop; i += WIDTH) {
+
+			if (t._count) {
+				t = t.tail_push();
+			}
+
+			size_type end = (stop - i < WIDTH) ? stop : i + WIDTH;
+
+			auto chunk = make_pooled<_chunk_>();
+
+			chunk->_values.assign(items.begin() + i, items.begin() + end);
+
+			t._tail   = chunk;
+			t._count += end - i;
+		}
+
+		return t;
+	}
+
+	_vector_::chunk_ptr _vector_::_trie_::push_tail(size_type level, const chunk_ptr& parent, const chunk_ptr& tail) const {
+
+		size_type index = ((_count - 1) >> level) & MASK;
+
+		auto node = parent ? make_pooled<_chunk_>(*parent) : make_pooled<_chunk_>();
+
+		chunk_ptr child;
+
+		if (level == BITS) {
+			child = tail;
+		}
+		else if (index < node->_branches.size()) {
+			child = push_tail(level - BITS, parent->_branches[index], tail);
+		}
+		else {
+			child = new_path(level - BITS, tail);
+		}
+
+		if (index < node->_branches.size()) {
+			node->_branches[index] = child;
+		}
+		else {
+			node->_branches.emplace_back(child);
+		}
+
+		return node;
+	}
+
+	_vector_::chunk_ptr _vector_::_trie_::pop_tail(size_type level, const chunk_ptr& node) const {
+
+		size_type index = ((_count - 2) >> level) & MASK;
+
+		if (level > BITS) {
+
+			chunk_ptr child = pop_tail(level - BITS, node->_branches[index]);
+
+			if (!child && index == 0) {
+				return chunk_ptr();
+			}
+
+			auto copy = make_pooled<_chunk_>(*node);
+
+			if (child) {
+				copy->_branches[index] = child;
+			}
+			else {
+				copy->_branches.resize(index);
+			}
+
+			return copy;
+		}
+
+		if (index == 0) {
+			return chunk_ptr();
+		}
+
+		auto copy = make_pooled<_chunk_>(*node);
+
+		copy->_branches.resize(index);
+
+		return copy;
+	}
+
+	_vector_::chunk_ptr _vector_::_trie_::new_path(size_type level, const chunk_ptr& node) {
+
+		if (level == 0) {
+			return node;
+		}
+
+		auto path = make_pooled<_chunk_>();
+
+		path->_branches.emplace_back(new_path(level - BITS, node));
+
+		return path;
+	}
+
+	_vector_::chunk_ptr _vector_::_trie_::drop_path(size_type level, const chunk_ptr& node, size_type start) {
+
+		auto copy = make_pooled<_chunk_>(*node);
+
+		size_type index = (start >> level) & MASK;
+		size_type stop  = std::min(index, copy->_branches.size());
+
+		for (size_type i = 0; i < stop; i += 1) {
+			copy->_branches[i].reset();
+		}
+
+		if (level > BITS && index < copy->_branches.size()) {
+			copy->_branches[index] = drop_path(level - BITS, node->_branches[index], start);
+		}
+
+		return copy;
+	}
+
+	_vector_::chunk_ptr _vector_::_trie_::set_path(size_type level, const chunk_ptr& node, size_type i, const let& other) const {
+
+		auto copy = make_pooled<_chunk_>(*node);
+
+		if (level == 0) {
+			copy->_values[i & MASK] = other;
+		}
+		else {
+			size_type index = (i >> level) & MASK;
+
+			copy->_branches[index] = set_path(level - BITS, node->_branches[index], i, other);
+		}
+
+		return copy;
+	}
+
+	/********************************************************************************************/
+	//
+	//                            '_vector_builder_' Class Implimentation
+	//
+	/********************************************************************************************/
+
+	_vector_builder_::_vector_builder_() : _vector(), _tail() {
+	}
+
+	size_type _vector_builder_::size() const {
+		return _vector._back._count + (_tail ? _tail->_values.size() : 0);
+	}
+
+	void _vector_builder_::place_last(let other) {
+
+		if (other.is_nothing()) {
+			return;
+		}
+
+		if (_tail && _tail->_values.size() == _vector_::WIDTH) {
+			/*
+				The tail is full, so move it into the trie.  The
+				trie now shares the chunk, so begin a new tail.
+			*/
+
+			_vector._back._tail   = _tail;
+			_vector._back._count += _vector_::WIDTH;
+
+			_vector._back = _vector._back.tail_push();
+
+			_tail.reset();
+		}
+
+		if (!_tail) {
+			_tail = make_pooled<_vector_::_chunk_>();
+			_tail->_values.reserve(_vector_::WIDTH);
+		}
+
+		_tail->_values.emplace_back(std::move(other));
+	}
+
+	_vector_ _vector_builder_::persistent() {
+
+		_vector_ v = _vector;
+
+		if (_tail) {
+			v._back._tail   = _tail;
+			v._back._count += _tail->_values.size();
+		}
+
+		_vector = _vector_();
+		_tail.reset();
+
+		return v;
+	}
+
+} // end
@@ -21,7 +21,11 @@
 //			
 /********************************************************************************************/
 
+#include <deque>
 #include <map>
+#include <mutex>
+#include <unordered_map>
+
 #include "expression.h"
 #include ".\support\op_codes.h"
 
@@ -54,12 +58,22 @@ namespace Olly {
 
 		friend bool           _is_(const op_call& self);
 		friend str_type        _type_(const op_call& self);
+		friend TYPE_KIND       _kind_(const op_call& self);
 		friend real_type       _comp_(const op_call& self, const let& other);
-		friend void          _str_(stream_type& out, const op_call& self);
-		friend void         _repr_(stream_type& out, const op_call& self);
+		friend std::size_t     _hash_(const op_call& self);
+		friend void          _str_(output_sink& out, const op_call& self);
+		friend void         _repr_(output_sink& out, const op_call& self);
+		friend void       _encode_(encoder& out, const op_call& self);
 		friend OP_CODE   _op_code_(const op_call& self);
 	};
 
+	template <>
+	struct inline_storage<op_call> {
+		static const bool_type value = true;
+	};
+
+	static_assert(let::is_inline<op_call>(), "An op_call must fit within let::INLINE_SIZE.");
+
 
 	op_call::op_call() : _value() {
 	}
@@ -72,11 +86,11 @@ namespace Olly {
 
 	op_call::op_call(str_type str) : _value() {
 
-		auto it = OPERATORS.find(str);
+		const operator_entry* entry = find_operator(str);
 
-		if (it != OPERATORS.end()) {
+		if (entry) {
 
-			_value = it->second;
+			_value = entry->code;
 		}
 	}
 
@@ -98,6 +112,10 @@ namespace Olly {
 		return "op_call";
 	}
 
+	TYPE_KIND _kind_(const op_call& self) {
+		return TYPE_KIND::OP_CALL_TYPE;
+	}
+
 	real_type _comp_(const op_call& self, const let& other) {
 
 		const op_call* s = other.cast<op_call>();
@@ -115,31 +133,131 @@ namespace Olly {
 		return NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const op_call& self) {
+	std::size_t _hash_(const op_call& self) {
+		return hash_combine(static_cast<std::size_t>(TYPE_KIND::OP_CALL_TYPE), static_cast<std::size_t>(self._value));
+	}
 
-		for (auto it = OPERATORS.cbegin(); it != OPERATORS.cend(); ++it) {
+	void _str_(output_sink& out, const op_call& self) {
 
-			if (it->second == self._value) {
+		std::string_view name = OPERATOR_NAMES[static_cast<size_type>(self._value)];
 
-				out << it->first;
-				return;
-			}
+		if (name.empty()) {
+			out << "unknown_operator";
+			return;
 		}
 
-		out << "unknown_operator";
+		out << name;
 	}
 
-	void _repr_(stream_type& out, const op_call& self) {
+	void _repr_(output_sink& out, const op_call& self) {
 		_str_(out, self);
 	}
 
+	void _encode_(encoder& out, const op_call& self) {
+		out.write_kind(TYPE_KIND::OP_CALL_TYPE);
+		out.write_size(static_cast<size_type>(self._value));
+	}
+
 	OP_CODE _op_code_(const op_call& self) {
 
 		return self._value;
 	}
 
+	/********************************************************************************************/
+	//
+	//                                'op_call' Interned Values
+	//
+	//        A single immutable 'let' is created for every operation code the first
+	//        time one is requested.  The interpreter copies these shared instances
+	//        rather than constructing a new op_call on every operator rewrite.  
+	//
+	/********************************************************************************************/
+
+	std::vector<let> make_op_call_values() {
+
+		size_type end = static_cast<size_type>(OP_CODE::END_OPERATORS_OP);
+
+		std::vector<let> values;
+		values.reserve(end + 1);
+
+		for (size_type i = 0; i <= end; i += 1) {
+			values.emplace_back(op_call(static_cast<OP_CODE>(i)));
+		}
+
+		return values;
+	}
+
+	const let& op_call_value(OP_CODE code) {
+
+		static const std::vector<let> OP_CALL_VALUES = make_op_call_values();
+
+		return OP_CALL_VALUES[static_cast<size_type>(code)];
+	}
+
+
+
+
+	/********************************************************************************************/
+	//
+	//                                  'symbol' Intern Table
+	//
+	//        Every symbol name is interned once and given a dense integer id.  The
+	//        names are held in a deque so a reference to one is never invalidated,
+	//        and the table is guarded so symbols may be created from any thread.  
+	//        The hash of each name is computed once, as it is interned.
+	//
+	/********************************************************************************************/
+
+	struct interned_name {
+		str_type     text;
+		size_type    hash;    // The hash of the text, which unlike the id does not depend upon the order of interning.
+	};
+
+	struct symbol_table {
+		std::mutex                                  lock;
+		std::unordered_map<str_type, size_type>      ids;
+		std::deque<interned_name>                  names;
+	};
+
+	symbol_table& get_symbol_table() {
+
+		static symbol_table table;
+
+		return table;
+	}
+
+	size_type intern_symbol(const str_type& name) {
+
+		symbol_table& table = get_symbol_table();
+
+		std::lock_guard<std::mutex> guard(table.lock);
+
+		auto itr = table.ids.find(name);
+
+		if (itr != table.ids.end()) {
+			return itr->second;
+		}
+
+		size_type id = table.names.size();
+
+		table.names.emplace_back(interned_name{ name, DEFAULT_HASH_FUNCTION(name) });
+		table.ids.emplace(name, id);
+
+		return id;
+	}
+
+	const interned_name& symbol_entry(size_type id) {
 
+		symbol_table& table = get_symbol_table();
 
+		std::lock_guard<std::mutex> guard(table.lock);
+
+		return table.names[id];
+	}
+
+	const str_type& symbol_text(size_type id) {
+		return symbol_entry(id).text;
+	}
 
 	/********************************************************************************************/
 	//
@@ -153,7 +271,8 @@ namespace Olly {
 
 	class symbol {
 
-		str_type _value;
+		size_type              _id;
+		const interned_name*  _value;    // The interned name.
 
 
 	public:
@@ -163,30 +282,44 @@ namespace Olly {
 		symbol(str_type str);
 		virtual ~symbol();
 
+		const str_type& name() const;
+		size_type         id() const;
+
 		friend  stream_type& operator >> (stream_type& stream, symbol& self);
 
 		friend bool           _is_(const symbol& self);
 		friend str_type        _type_(const symbol& self);
+		friend TYPE_KIND       _kind_(const symbol& self);
 		friend real_type       _comp_(const symbol& self, const let& other);
-		friend void          _str_(stream_type& out, const symbol& self);
-		friend void         _repr_(stream_type& out, const symbol& self);
+		friend std::size_t     _hash_(const symbol& self);
+		friend void          _str_(output_sink& out, const symbol& self);
+		friend void         _repr_(output_sink& out, const symbol& self);
+		friend void       _encode_(encoder& out, const symbol& self);
 
 		friend str_type        _help_(const symbol& self);
 	};
 
 
-	symbol::symbol() : _value("") {
+	symbol::symbol() : _id(intern_symbol("")), _value(&symbol_entry(_id)) {
 	}
 
-	symbol::symbol(const symbol& obj) : _value(obj._value) {
+	symbol::symbol(const symbol& obj) : _id(obj._id), _value(obj._value) {
 	}
 
-	symbol::symbol(str_type str) : _value(str) {
+	symbol::symbol(str_type str) : _id(intern_symbol(str)), _value(&symbol_entry(_id)) {
 	}
 
 	symbol::~symbol() {
 	}
 
+	const str_type& symbol::name() const {
+		return _value->text;
+	}
+
+	size_type symbol::id() const {
+		return _id;
+	}
+
 	stream_type& operator >> (stream_type& stream, symbol& self) {
 
 		self = symbol(stream.str());
@@ -195,40 +328,80 @@ namespace Olly {
 	}
 
 	bool _is_(const symbol& self) {
-		return !self._value.empty();
+		return !self._value->text.empty();
 	}
 
 	str_type _type_(const symbol& self) {
 		return "symbol";
 	}
 
+	TYPE_KIND _kind_(const symbol& self) {
+		return TYPE_KIND::SYMBOL_TYPE;
+	}
+
 	real_type _comp_(const symbol& self, const let& other) {
 
 		const symbol* s = other.cast<symbol>();
 
 		if (s) {
-			if (self._value > s->_value) {
-				return 1.0;
+			if (self._id == s->_id) {
+				return 0.0;
 			}
-			if (self._value < s->_value) {
-				return -1.0;
+			if (self._value->text > s->_value->text) {
+				return 1.0;
 			}
-			return 0.0;
+			return -1.0;
 		}
 
 		return NOT_A_NUMBER;
 	}
 
-	void _str_(stream_type& out, const symbol& self) {
-		out << self._value;
+	std::size_t _hash_(const symbol& self) {
+		/*
+			Hash the name rather than the id, as ids depend upon
+			the order symbols are interned.  So a set keyed by
+			symbols keeps the same order from one run to the next.
+			The hash of the name is kept by the intern table.
+		*/
+
+		return hash_combine(static_cast<std::size_t>(TYPE_KIND::SYMBOL_TYPE), self._value->hash);
+	}
+
+	void _str_(output_sink& out, const symbol& self) {
+		out << self._value->text;
 	}
 
-	void _repr_(stream_type& out, const symbol& self) {
+	void _repr_(output_sink& out, const symbol& self) {
 		_str_(out, self);
 	}
 
+	void _encode_(encoder& out, const symbol& self) {
+		out.write_kind(TYPE_KIND::SYMBOL_TYPE);
+		out.write_text(self._value->text);
+	}
+
 	str_type _help_(const symbol& self) {
 		return "symbol";
 	}
 
+	template <> struct inline_storage<symbol> {
+		static const bool_type value = true;
+	};
+
+	static_assert(let::is_inline<symbol>(), "A symbol must fit within let::INLINE_SIZE.");
+
+	size_type symbol_id(const let& var) {
+		/*
+			Return the interned id of a symbol, or of the text of any other object.
+		*/
+
+		const symbol* s = var.cast<symbol>();
+
+		if (s) {
+			return s->id();
+		}
+
+		return intern_symbol(str(var));
+	}
+
 } // end